@@ -3,6 +3,7 @@
 #include <Pipe/Memory/NewDelete.h>
 //  Override as first include
 
+#include <AST/Utils/MemoryStats.h>
 #include <AST/Utils/ModuleUtils.h>
 #include <ASTModule.h>
 #include <Compiler/Compiler.h>
@@ -17,6 +18,7 @@
 
 #include <chrono>
 #include <CLI/CLI.hpp>
+#include <cstdio>
 
 
 
@@ -74,6 +76,8 @@ int main(int argc, char** argv)
 	CLI::App app{"Rift compiler"};
 	String path;
 	app.add_option("-p,--project", path, "Project path")->required();
+	bool printStats = false;
+	app.add_flag("--stats", printStats, "Print memory statistics of the project as JSON");
 
 
 	String selectedBackendStr;
@@ -98,6 +102,12 @@ int main(int argc, char** argv)
 	CompilerConfig config;
 	Build(ast, config, backend);
 
+	if (printStats)
+	{
+		const String json = AST::MemoryStatsToJson(AST::GetMemoryStats(ast));
+		std::printf("%s\n", json.c_str());
+	}
+
 	while (true)
 	{
 		// Live for a second to let the profiler connect. Temporal
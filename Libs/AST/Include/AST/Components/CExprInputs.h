@@ -2,9 +2,11 @@
 #pragma once
 
 #include "AST/Id.h"
+#include "AST/Utils/SmallArray.h"
 
 #include <Pipe/PipeECS.h>
 #include <Pipe/Reflect/Struct.h>
+#include <Pipe/Serialize/Serialization.h>
 
 
 namespace rift::AST
@@ -32,11 +34,9 @@ namespace rift::AST
 	{
 		STRUCT(CExprInputs, p::Struct)
 
-		PROP(linkedOutputs)
-		p::TArray<ExprOutput> linkedOutputs;
-
-		PROP(pinIds)
-		p::TArray<AST::Id> pinIds;
+		// Not reflected. Serialized by Read/Write below and drawn by the AST debugger
+		TSmallArray<ExprOutput> linkedOutputs;
+		TSmallArray<AST::Id> pinIds;
 
 
 		CExprInputs& Add(AST::Id pinId)
@@ -66,4 +66,17 @@ namespace rift::AST
 			pinIds.Resize(count, AST::NoId);
 		}
 	};
+
+	static void Read(p::Reader& ct, CExprInputs& val)
+	{
+		ct.BeginObject();
+		ct.Next("linkedOutputs", val.linkedOutputs);
+		ct.Next("pinIds", val.pinIds);
+	}
+	static void Write(p::Writer& ct, const CExprInputs& val)
+	{
+		ct.BeginObject();
+		ct.Next("linkedOutputs", val.linkedOutputs);
+		ct.Next("pinIds", val.pinIds);
+	}
 }    // namespace rift::AST
@@ -2,9 +2,11 @@
 #pragma once
 
 #include "AST/Id.h"
+#include "AST/Utils/SmallArray.h"
 
 #include <Pipe/PipeECS.h>
 #include <Pipe/Reflect/Struct.h>
+#include <Pipe/Serialize/Serialization.h>
 
 
 namespace rift::AST
@@ -32,8 +34,8 @@ namespace rift::AST
 	{
 		STRUCT(CExprOutputs, p::Struct)
 
-		PROP(pinIds)
-		p::TArray<AST::Id> pinIds;
+		// Not reflected. Serialized by Read/Write below and drawn by the AST debugger
+		TSmallArray<AST::Id> pinIds;
 
 
 		CExprOutputs() {}
@@ -60,4 +62,15 @@ namespace rift::AST
 			return *this;
 		}
 	};
+
+	static void Read(p::Reader& ct, CExprOutputs& val)
+	{
+		ct.BeginObject();
+		ct.Next("pinIds", val.pinIds);
+	}
+	static void Write(p::Writer& ct, const CExprOutputs& val)
+	{
+		ct.BeginObject();
+		ct.Next("pinIds", val.pinIds);
+	}
 }    // namespace rift::AST
@@ -2,6 +2,7 @@
 #pragma once
 
 #include <Pipe/Core/Tag.h>
+#include <Pipe/PipeArrays.h>
 #include <Pipe/Reflect/Struct.h>
 
 
@@ -38,89 +39,69 @@ namespace rift::AST
 	}
 
 
+	/**
+	 * Interned scope path (E.g: "@Module.Type.Function")
+	 * Each distinct path is stored once in a global table and referenced by a small handle, so
+	 * copies are trivial and equality is a single comparison. Paths are never released, so
+	 * handles stay valid when stored outside of a tree or after it is reset.
+	 */
 	struct Namespace : public p::Struct
 	{
 		STRUCT(Namespace, p::Struct)
 
-		static constexpr p::i32 scopeCount = 8;
-		p::Tag scopes[scopeCount];    // TODO: Implement Inline arrays
+		// Index into the namespace table. 0 is the empty namespace
+		p::u32 handle = 0;
 
 
 		Namespace() = default;
-		template<p::i32 M>
-		Namespace(p::Tag scopes[M])
-		    requires(M <= scopeCount)
-		    : scopes{scopes}
-		{}
 		Namespace(p::StringView value);
 		// Prevent initializer list from stealing string constructor
 		Namespace(const p::String& value) : Namespace(p::StringView{value}) {}
 		Namespace(std::initializer_list<p::Tag> values)
-		{
-			const p::i32 size = p::math::Min(p::i32(values.size()), scopeCount);
-			for (p::i32 i = 0; i < size; ++i)
-			{
-				scopes[i] = *(values.begin() + i);
-			}
-		}
+		    : Namespace(p::TView<const p::Tag>{values.begin(), p::i32(values.size())})
+		{}
+		Namespace(p::TView<const p::Tag> scopes);
+		// Namespace of a child scope
+		Namespace(const Namespace& parent, p::Tag scope);
 
-		bool Equals(const Namespace& other) const;
-		bool IsEmpty() const;
-		p::i32 Size() const;
-		bool Contains(const Namespace& other) const;
-		p::String ToString(bool isLocal = false) const;
-		p::Tag& First()
+		bool Equals(const Namespace& other) const
 		{
-			return scopes[0];
+			return handle == other.handle;
 		}
-		p::Tag First() const
+		bool IsEmpty() const
 		{
-			return scopes[0];
-		}
-		p::Tag& Last()
-		{
-			const p::i32 size      = Size();
-			const p::i32 lastIndex = size > 0 ? (size - 1) : 0;    // Is Size is 0, last is first
-			return scopes[lastIndex];
-		}
-		const p::Tag& Last() const
-		{
-			const p::i32 size      = Size();
-			const p::i32 lastIndex = size > 0 ? (size - 1) : 0;    // Is Size is 0, last is first
-			return scopes[lastIndex];
+			return handle == 0;
 		}
+		p::i32 Size() const;
+		// @return true if other is this namespace or is inside it
+		bool Contains(const Namespace& other) const;
+		p::String ToString(bool isLocal = false) const;
+		p::TView<const p::Tag> GetScopes() const;
+		Namespace GetParent() const;
+		p::sizet GetHash() const;
+		p::Tag First() const;
+		p::Tag Last() const;
 		bool operator==(const Namespace& other) const
 		{
 			return Equals(other);
 		}
-		p::Tag operator[](p::i32 index) const
-		{
-			Check(index >= 0 && index < scopeCount);
-			return scopes[index];
-		}
+		// @return scope at index or None if out of bounds
+		p::Tag operator[](p::i32 index) const;
 		operator bool() const
 		{
 			return !IsEmpty();
 		}
 
-		p::Tag* begin()
-		{
-			return scopes;
-		}
-		const p::Tag* begin() const
-		{
-			return scopes;
-		}
-		p::Tag* end()
-		{
-			return scopes + Size();
-		}
-		const p::Tag* end() const
-		{
-			return scopes + Size();
-		}
+		const p::Tag* begin() const;
+		const p::Tag* end() const;
 
 		void Read(p::Reader& ct);
 		void Write(p::Writer& ct) const;
+
+		// Number of interned namespaces
+		static p::u32 GetTableSize();
+		// Bytes used by the table of interned namespaces
+		static p::sizet GetTableBytes();
 	};
+
 }    // namespace rift::AST
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "AST/Id.h"
+#include "AST/Utils/SmallArray.h"
 
 #include <Pipe/Reflect/Struct.h>
 #include <Pipe/Serialize/Serialization.h>
@@ -25,18 +26,29 @@ namespace rift::AST
 	{
 		STRUCT(CStmtOutputs, p::Struct)
 
-		// Both arrays keep the same index to the input node and the output pin
-		PROP(pinIds)
-		TArray<Id> pinIds;
-		PROP(linkInputNodes)
-		TArray<Id> linkInputNodes;
+		// Both arrays keep the same index to the input node and the output pin.
+		// Not reflected. Serialized by Read/Write below and drawn by the AST debugger
+		TSmallArray<Id> pinIds;
+		TSmallArray<Id> linkInputNodes;
 
 
 		CStmtOutputs() = default;
-		CStmtOutputs(p::TArray<Id> pins) : pinIds{Move(pins)}, linkInputNodes(pinIds.Size(), NoId)
-		{}
+		CStmtOutputs(TView<const Id> pins) : pinIds(pins), linkInputNodes(pinIds.Size(), NoId) {}
 	};
 
+	static void Read(Reader& ct, CStmtOutputs& val)
+	{
+		ct.BeginObject();
+		ct.Next("pinIds", val.pinIds);
+		ct.Next("linkInputNodes", val.linkInputNodes);
+	}
+	static void Write(Writer& ct, const CStmtOutputs& val)
+	{
+		ct.BeginObject();
+		ct.Next("pinIds", val.pinIds);
+		ct.Next("linkInputNodes", val.linkInputNodes);
+	}
+
 	static void Read(Reader& ct, CStmtOutput& val)
 	{
 		ct.Serialize(val.linkInputNode);
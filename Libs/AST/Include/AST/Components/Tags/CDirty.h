@@ -2,6 +2,8 @@
 #pragma once
 
 #include "AST/Components/CExprCall.h"
+#include "AST/Components/CExprDeclRef.h"
+#include "AST/Components/CExprInputs.h"
 #include "AST/Components/CFileRef.h"
 
 #include <Pipe/Reflect/Struct.h>
@@ -24,4 +26,10 @@ namespace rift::AST
 
 	// Marks a type as dirty, meaning is has been modified
 	using CCallDirty = TDirty<CExprCallId>;
+
+	// Marks an expression node whose pins were added or invalidated
+	using CPinsDirty = TDirty<CExprInputs>;
+
+	// Marks a declaration reference whose type needs to be resolved
+	using CDeclRefDirty = TDirty<CExprDeclRefId>;
 }    // namespace rift::AST
@@ -0,0 +1,31 @@
+// Copyright 2015-2023 Piperift - All rights reserved
+#pragma once
+
+#include "AST/Id.h"
+
+#include <Pipe/Reflect/Struct.h>
+
+
+namespace rift::AST
+{
+	using namespace p::core;
+
+	// Caches which expression nodes can be reached walking the inputs of a node, so that
+	// repeated loop checks (E.g: while dragging a link) don't walk the graph again.
+	// Entries are grouped by the graph (function or type) owning the nodes. Editing the links of
+	// a graph clears its entries only
+	struct SExprReachability : public Struct
+	{
+		STRUCT(SExprReachability, Struct)
+
+		// Graphs cached at once. All are cleared when the limit is reached
+		static constexpr i32 maxGraphs = 8;
+
+		// Sorted upstream nodes of each queried node, by the id of their graph
+		TMap<Id, TMap<Id, TArray<Id>>> upstreamByGraph;
+
+		// Visited marks indexed by id index. A node is visited if its mark is visitGeneration
+		TArray<u32> visitMarks;
+		u32 visitGeneration = 0;
+	};
+}    // namespace rift::AST
@@ -0,0 +1,32 @@
+// Copyright 2015-2023 Piperift - All rights reserved
+#pragma once
+
+#include "AST/Id.h"
+
+#include <Pipe/Reflect/Struct.h>
+
+
+namespace rift::AST
+{
+	using namespace p::core;
+
+	/**
+	 * Flat copy of the hierarchy in depth-first order. The subtree of an entity is the
+	 * contiguous range of ids starting at its position, so walking it doesn't jump between the
+	 * children arrays of each parent.
+	 */
+	struct SHierarchy : public Struct
+	{
+		STRUCT(SHierarchy, Struct, Struct_NotSerialized)
+
+		TArray<Id> ids;
+		// Number of entities in the subtree of each position, including itself
+		TArray<i32> subtreeSizes;
+		// Position of each entity by id index. NO_INDEX if not part of any hierarchy
+		TArray<i32> positions;
+
+		// Set by hooks when the hierarchy changes. AttachChildren and RemoveWithChildren update
+		// the index in place instead
+		bool dirty = true;
+	};
+}    // namespace rift::AST
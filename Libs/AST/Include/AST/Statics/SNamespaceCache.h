@@ -0,0 +1,33 @@
+// Copyright 2015-2023 Piperift - All rights reserved
+#pragma once
+
+#include "AST/Components/CNamespace.h"
+#include "AST/Id.h"
+
+#include <Pipe/Core/Tag.h>
+#include <Pipe/Reflect/Struct.h>
+
+
+namespace rift::AST
+{
+	using namespace p::core;
+
+	struct CachedNamespace
+	{
+		Namespace ns;
+		Tag fullName;
+		Tag localFullName;
+	};
+
+	/**
+	 * Resolved namespaces and full names of named entities. Filled when an entity is named,
+	 * attached or changed, and invalidated when a name or parent in its hierarchy is removed.
+	 * Getters never write it. Systems adding names or parents write it through their hooks
+	 */
+	struct SNamespaceCache : public Struct
+	{
+		STRUCT(SNamespaceCache, Struct)
+
+		TMap<Id, CachedNamespace> entries;
+	};
+}    // namespace rift::AST
@@ -0,0 +1,24 @@
+// Copyright 2015-2023 Piperift - All rights reserved
+#pragma once
+
+#include "AST/Id.h"
+
+#include <Pipe/Reflect/Struct.h>
+#include <Pipe/Reflect/TypeId.h>
+
+
+namespace rift::AST
+{
+	using namespace p::core;
+
+	// Counts how many times components of each tracked pool have been added or removed
+	struct SPoolVersions : public Struct
+	{
+		STRUCT(SPoolVersions, Struct)
+
+		TMap<p::TypeId, p::u64> versions;
+		// Changes with every transaction, undo or redo. Edits don't always add or remove
+		// components, so they are versioned apart
+		p::u64 editVersion = 0;
+	};
+}    // namespace rift::AST
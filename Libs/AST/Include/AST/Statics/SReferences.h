@@ -0,0 +1,28 @@
+// Copyright 2015-2023 Piperift - All rights reserved
+#pragma once
+
+#include "AST/Id.h"
+
+#include <Pipe/Reflect/Struct.h>
+
+
+namespace rift::AST
+{
+	using namespace p::core;
+
+	// Reverse index from declarations (functions, variables and types) to the expressions
+	// referencing them through CExprCallId, CExprDeclRefId or CExprTypeId
+	struct SReferences : public Struct
+	{
+		STRUCT(SReferences, Struct)
+
+		// Sorted expression ids per declaration. May contain stale ids, removed when queried
+		TMap<Id, TArray<Id>> exprsByDecl;
+		// Expressions added or modified since the last query. Indexed lazily since their
+		// referenced ids are often assigned after the component is added.
+		// One list per component so that systems writing different ones can run in parallel
+		TArray<Id> pendingCallExprs;
+		TArray<Id> pendingDeclRefExprs;
+		TArray<Id> pendingTypeExprs;
+	};
+}    // namespace rift::AST
@@ -0,0 +1,26 @@
+// Copyright 2015-2023 Piperift - All rights reserved
+#pragma once
+
+#include "AST/Id.h"
+
+#include <Pipe/Memory/OwnPtr.h>
+#include <Pipe/Reflect/Struct.h>
+
+
+namespace rift::AST
+{
+	using namespace p::core;
+
+	struct Tree;
+
+
+	// Last snapshot taken from a tree, reused until the tree changes
+	struct SSnapshot : public Struct
+	{
+		STRUCT(SSnapshot, Struct, Struct_NotSerialized)
+
+		TOwnPtr<Tree> tree;
+		// Last pool version of the tree when the snapshot was taken
+		u64 version = 0;
+	};
+}    // namespace rift::AST
@@ -0,0 +1,61 @@
+// Copyright 2015-2023 Piperift - All rights reserved
+#pragma once
+
+#include "AST/Id.h"
+
+#include <Pipe/Reflect/Struct.h>
+#include <Pipe/Reflect/TypeId.h>
+
+#include <memory>
+
+
+namespace rift::AST
+{
+	using namespace p::core;
+
+	struct Tree;
+
+
+	// Values of one component type on the entities touched by a transaction
+	struct ComponentDeltas
+	{
+		p::TypeId typeId;
+
+
+		virtual ~ComponentDeltas() = default;
+
+		// Tracks entities created by the transaction. They had no values before it
+		virtual void AddCreated(TView<const Id> createdIds) = 0;
+		// Captures the values after the transaction. Returns false if none changed
+		virtual bool CaptureAfter(Tree& ast) = 0;
+		// Restores the values from before or after the transaction
+		virtual void Restore(Tree& ast, bool after) = 0;
+		// Replaces ids of entities that were recreated, including ids stored in values
+		virtual void RemapIds(const TMap<Id, Id>& remap) = 0;
+	};
+
+	struct UndoTransaction
+	{
+		TArray<Id> ids;
+		// Entities destroyed by the transaction. Recreated by undo and destroyed again by redo
+		TArray<Id> destroyedIds;
+		// Entities created by the transaction. Destroyed by undo and recreated by redo
+		TArray<Id> createdIds;
+		TArray<std::unique_ptr<ComponentDeltas>> deltas;
+	};
+
+	// Bounded ring buffer of recorded transactions
+	struct SUndoHistory : public Struct
+	{
+		STRUCT(SUndoHistory, Struct, Struct_NotSerialized)
+
+		static constexpr i32 capacity = 128;
+
+		TArray<UndoTransaction> transactions;
+		// Index of the oldest transaction in the ring
+		i32 first = 0;
+		i32 count = 0;
+		// Number of transactions that can be undone. Next ones can be redone
+		i32 undoable = 0;
+	};
+}    // namespace rift::AST
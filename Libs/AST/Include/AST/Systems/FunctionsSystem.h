@@ -6,6 +6,7 @@
 #include "AST/Components/CExprInputs.h"
 #include "AST/Components/CExprOutputs.h"
 #include "AST/Components/CNamespace.h"
+#include "AST/Components/Tags/CDirty.h"
 #include "AST/Components/Tags/CInvalid.h"
 #include "AST/Tree.h"
 
@@ -27,8 +28,11 @@ namespace rift::AST::FunctionsSystem
 	void ResolveCallFunctionIds(
 	    p::TAccessRef<p::TWrite<CExprCallId>, CExprCall, CDeclFunction, CNamespace, CParent, CChild>
 	        access);
-	void PushInvalidPinsBack(
-	    p::TAccessRef<p::TWrite<CExprInputs>, p::TWrite<CExprOutputs>, CInvalid> access);
+
+	using PushInvalidPinsAccess = p::TAccessRef<p::TWrite<CExprInputs>, p::TWrite<CExprOutputs>,
+	    CInvalid, p::TWrite<CPinsDirty>>;
+	// Moves invalid pins of dirty nodes after valid ones
+	void PushInvalidPinsBack(PushInvalidPinsAccess access);
 
 	// Marks calls referencing dirty functions as dirty theirselfs
 	void PropagateDirtyIntoCalls(Tree& ast);
@@ -10,6 +10,7 @@
 #include "AST/Components/CExprType.h"
 #include "AST/Components/CExprUnaryOperator.h"
 #include "AST/Components/Tags/CChanged.h"
+#include "AST/Components/Tags/CDirty.h"
 
 #include <Pipe/PipeECS.h>
 
@@ -27,8 +28,11 @@ namespace rift::AST::TypeSystem
 	void Init(Tree& ast);
 
 	using PropagateVariableTypesAccess =
-	    TAccessRef<CExprDeclRefId, CDeclVariable, TWrite<CExprTypeId>>;
+	    TAccessRef<CExprDeclRefId, CDeclVariable, TWrite<CExprTypeId>, TWrite<CDeclRefDirty>>;
+	// Resolves the type of dirty declaration references
 	void PropagateVariableTypes(PropagateVariableTypesAccess access);
+	// Marks all references to a variable dirty after its type changed
+	void MarkVariableRefsDirty(Tree& ast, Id variableId);
 
 	using PropagateExpressionTypesAccess = TAccessRef<CDeclType, CChanged, CExprInputs,
 	    CExprOutputs, TWrite<CExprTypeId>, CExprUnaryOperator, CExprBinaryOperator, CParent>;
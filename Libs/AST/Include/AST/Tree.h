@@ -8,6 +8,8 @@
 #include <Pipe/Memory/UniquePtr.h>
 #include <Pipe/PipeECS.h>
 
+#include <array>
+
 
 namespace rift::AST
 {
@@ -26,6 +28,15 @@ namespace rift::AST
 		AST::Id u64Id    = AST::NoId;
 		AST::Id i64Id    = AST::NoId;
 		AST::Id stringId = AST::NoId;
+
+		static constexpr p::i32 count = 13;
+
+
+		std::array<AST::Id, count> GetAll() const
+		{
+			return {voidId, boolId, floatId, doubleId, u8Id, i8Id, u16Id, i16Id, u32Id, i32Id,
+			    u64Id, i64Id, stringId};
+		}
 	};
 
 
@@ -56,6 +67,12 @@ namespace rift::AST
 		void MoveFrom(Tree&& other);
 
 		void SetupNativeTypes();
+		void BindHooks();
+		void BindNamespaceCache();
+		void BindReferenceIndex();
+		void BindExprReachability();
+		void BindHierarchy();
+		void BindPoolVersions();
 	};
 
 
@@ -0,0 +1,174 @@
+// Copyright 2015-2023 Piperift - All rights reserved
+#pragma once
+
+#include "AST/Tree.h"
+#include "AST/Utils/ComponentDeltas.h"
+#include "AST/Utils/ComponentIds.h"
+#include "AST/Utils/MemoryStats.h"
+
+#include <Pipe/PipeArrays.h>
+#include <Pipe/PipeECS.h>
+#include <Pipe/Reflect/TypeId.h>
+
+#include <memory>
+#include <type_traits>
+
+
+namespace rift::AST
+{
+	// Maps ids of a tree to the ids of its compacted copy
+	struct IdRemap
+	{
+		// Old and new ids by old id index
+		p::TArray<Id> oldIds;
+		p::TArray<Id> newIds;
+
+
+		// @return the new id, or NoId if the entity was not kept
+		Id Get(Id oldId) const
+		{
+			const p::i32 index = p::i32(p::GetIdIndex(oldId));
+			if (oldId == NoId || index >= oldIds.Size() || oldIds[index] != oldId)
+			{
+				return NoId;
+			}
+			return newIds[index];
+		}
+	};
+
+	// Component pools known by compaction, undo and memory stats
+	struct CompactedPool
+	{
+		p::TypeId typeId;
+		// Appends the ids of entities with this component
+		void (*getIds)(Tree& ast, p::TArray<Id>& ids) = nullptr;
+		// Copies components into the compacted tree. Transient pools don't copy
+		void (*copy)(Tree& source, Tree& target, const IdRemap& remap) = nullptr;
+		void (*getMemoryStats)(Tree& ast, PoolMemoryStats& stats) = nullptr;
+		// Captures values for undo. Transient and untracked pools are not restored by undo
+		std::unique_ptr<ComponentDeltas> (*captureDeltas)(
+		    Tree& ast, p::TView<const Id> ids, bool hadValues) = nullptr;
+	};
+
+
+	// Statics moved into the compacted tree
+	struct CompactedStatic
+	{
+		p::TypeId typeId;
+		// Moves the static into the compacted tree and remaps the ids it stores
+		void (*move)(Tree& source, Tree& target, const IdRemap& remap) = nullptr;
+	};
+
+
+	/**
+	 * Renumbers all entities in depth-first hierarchy order and packs component pools in that
+	 * order, so that iterating a function or type touches contiguous memory.
+	 * Ids stored in components are remapped with VisitIds.
+	 * Statics registered with RegisterCompactedStatics are moved with their ids remapped. Other
+	 * statics are caches rebuilt by the compacted tree:
+	 * - Namespace cache and flat hierarchy are rebuilt when the tree is assigned.
+	 * - Reachability and pool versions start clean. Anything caching pool versions must
+	 *   refresh.
+	 * Snapshots are dropped, so builds reading them must be cancelled first.
+	 * @return false if the tree has components of a pool not registered for compaction. Debug
+	 * builds fail a check instead, since those components would be lost.
+	 */
+	bool CompactTree(Tree& ast);
+
+	p::TArray<CompactedPool>& GetCompactedPools();
+	p::TArray<CompactedStatic>& GetCompactedStatics();
+
+	void RemapStaticIds(p::TArray<Id>& ids, const IdRemap& remap);
+	void RemapStaticIds(p::TMap<p::Tag, Id>& ids, const IdRemap& remap);
+
+	template<typename T>
+	void GetCompactedPoolIds(Tree& ast, p::TArray<Id>& ids)
+	{
+		ids.Append(FindAllIdsWith<T>(ast));
+	}
+
+	template<typename T>
+	void CopyCompactedPool(Tree& source, Tree& target, const IdRemap& remap)
+	{
+		p::TArray<Id> ids = FindAllIdsWith<T>(source);
+		// Add components in the new order so that pools are packed in hierarchy order
+		ids.Sort([&remap](Id one, Id other) {
+			return p::GetIdIndex(remap.Get(one)) < p::GetIdIndex(remap.Get(other));
+		});
+		for (Id id : ids)
+		{
+			const Id newId = remap.Get(id);
+			if (IsNone(newId))
+			{
+				continue;
+			}
+
+			if constexpr (std::is_empty_v<T>)
+			{
+				if (!target.Has<T>(newId))
+				{
+					target.Add<T>(newId);
+				}
+			}
+			else
+			{
+				T value = source.Get<const T>(id);
+				VisitIds(value, [&remap](Id& valueId) {
+					valueId = remap.Get(valueId);
+				});
+				if (T* existing = target.TryGet<T>(newId))
+				{
+					*existing = p::Move(value);
+				}
+				else
+				{
+					target.Add(newId, p::Move(value));
+				}
+			}
+		}
+	}
+
+	// Registers components to be copied by compaction and restored by undo
+	template<typename... T>
+	void RegisterCompactedPools()
+	{
+		(GetCompactedPools().Add({p::GetTypeId<T>(), &GetCompactedPoolIds<T>,
+		     &CopyCompactedPool<T>, &GetPoolMemoryStats<T>, &CaptureComponentDeltas<T>}),
+		    ...);
+	}
+
+	// Registers components (like dirty tags or editor state) that are copied by compaction but
+	// not restored by undo
+	template<typename... T>
+	void RegisterUntrackedPools()
+	{
+		(GetCompactedPools().Add({p::GetTypeId<T>(), &GetCompactedPoolIds<T>,
+		     &CopyCompactedPool<T>, &GetPoolMemoryStats<T>}),
+		    ...);
+	}
+
+	// Registers components (like caches) that can be dropped by compaction
+	template<typename... T>
+	void RegisterTransientPools()
+	{
+		(GetCompactedPools().Add({p::GetTypeId<T>(), nullptr, nullptr, &GetPoolMemoryStats<T>}),
+		    ...);
+	}
+
+	template<typename T>
+	void MoveCompactedStatic(Tree& source, Tree& target, const IdRemap& remap)
+	{
+		if (T* value = source.TryGetStatic<T>())
+		{
+			target.SetStatic<T>(p::Move(*value));
+			RemapStaticIds(target.GetStatic<T>(), remap);
+		}
+	}
+
+	// Registers statics moved by compaction. Each needs a RemapStaticIds overload
+	template<typename... T>
+	void RegisterCompactedStatics()
+	{
+		(GetCompactedStatics().Add({p::GetTypeId<T>(), &MoveCompactedStatic<T>}), ...);
+	}
+}    // namespace rift::AST
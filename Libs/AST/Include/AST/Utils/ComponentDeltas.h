@@ -0,0 +1,200 @@
+// Copyright 2015-2023 Piperift - All rights reserved
+#pragma once
+
+#include "AST/Statics/SUndoHistory.h"
+#include "AST/Tree.h"
+#include "AST/Utils/ComponentIds.h"
+
+#include <Pipe/PipeArrays.h>
+#include <Pipe/PipeECS.h>
+#include <Pipe/Reflect/TypeId.h>
+
+#include <concepts>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <type_traits>
+
+
+namespace rift::AST
+{
+	/**
+	 * @return true if both values are known to be equal.
+	 * Components without operator== are compared bytewise if trivially copyable. Others are
+	 * always considered changed, which only costs keeping their value in the history.
+	 */
+	template<typename T>
+	bool AreSameValues(const std::optional<T>& a, const std::optional<T>& b)
+	{
+		if (a.has_value() != b.has_value())
+		{
+			return false;
+		}
+		if (!a.has_value() || std::is_empty_v<T>)
+		{
+			return true;
+		}
+		if constexpr (std::equality_comparable<T>)
+		{
+			return *a == *b;
+		}
+		else if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			return std::memcmp(&*a, &*b, sizeof(T)) == 0;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	template<typename T>
+	std::optional<T> CaptureValue(Tree& ast, Id id)
+	{
+		if (!ast.IsValid(id))
+		{
+			return std::nullopt;
+		}
+		if constexpr (std::is_empty_v<T>)
+		{
+			return ast.Has<T>(id) ? std::optional<T>{T{}} : std::nullopt;
+		}
+		else if (const T* value = ast.TryGet<const T>(id))
+		{
+			return *value;
+		}
+		return std::nullopt;
+	}
+
+	template<typename T>
+	struct TComponentDeltas : public ComponentDeltas
+	{
+		TArray<Id> ids;
+		TArray<std::optional<T>> before;
+		TArray<std::optional<T>> after;
+
+
+		TComponentDeltas()
+		{
+			typeId = p::GetTypeId<T>();
+		}
+
+		void AddCreated(TView<const Id> createdIds) override
+		{
+			ids.Append(createdIds);
+			before.Reserve(ids.Size());
+			for (i32 i = 0; i < createdIds.Size(); ++i)
+			{
+				before.Add(std::nullopt);
+			}
+		}
+
+		bool CaptureAfter(Tree& ast) override
+		{
+			after.Reserve(ids.Size());
+			for (Id id : ids)
+			{
+				after.Add(CaptureValue<T>(ast, id));
+			}
+
+			// Only keep values that changed
+			for (i32 i = ids.Size() - 1; i >= 0; --i)
+			{
+				if (AreSameValues(before[i], after[i]))
+				{
+					ids.RemoveAtSwapUnsafe(i);
+					before.RemoveAtSwapUnsafe(i);
+					after.RemoveAtSwapUnsafe(i);
+				}
+			}
+			return !ids.IsEmpty();
+		}
+
+		void Restore(Tree& ast, bool restoreAfter) override
+		{
+			const auto& values = restoreAfter ? after : before;
+			for (i32 i = 0; i < ids.Size(); ++i)
+			{
+				const Id id = ids[i];
+				if (!ast.IsValid(id))
+				{
+					continue;
+				}
+
+				// Components are replaced (not assigned) so that add and remove hooks keep
+				// caches like namespaces or the hierarchy up to date
+				if (ast.Has<T>(id))
+				{
+					ast.Remove<T>(id);
+				}
+				if (values[i].has_value())
+				{
+					if constexpr (std::is_empty_v<T>)
+					{
+						ast.Add<T>(id);
+					}
+					else
+					{
+						ast.Add(id, T{*values[i]});
+					}
+				}
+			}
+		}
+
+		void RemapIds(const TMap<Id, Id>& remap) override
+		{
+			auto remapId = [&remap](Id& id) {
+				if (const Id* newId = remap.Find(id))
+				{
+					id = *newId;
+				}
+			};
+			for (i32 i = 0; i < ids.Size(); ++i)
+			{
+				remapId(ids[i]);
+				if (before[i].has_value())
+				{
+					VisitIds(*before[i], remapId);
+				}
+				if (after[i].has_value())
+				{
+					VisitIds(*after[i], remapId);
+				}
+			}
+		}
+	};
+
+	/**
+	 * Captures the values of a component on the entities touched by a transaction.
+	 * If hadValues is false, none of the entities had the component before the transaction.
+	 * @return null if none of the entities has the component, so that transactions only
+	 * allocate deltas of the components they touch
+	 */
+	template<typename T>
+	std::unique_ptr<ComponentDeltas> CaptureComponentDeltas(
+	    Tree& ast, TView<const Id> ids, bool hadValues)
+	{
+		bool anyHas = false;
+		for (Id id : ids)
+		{
+			if (ast.IsValid(id) && ast.Has<T>(id))
+			{
+				anyHas = true;
+				break;
+			}
+		}
+		if (!anyHas)
+		{
+			return {};
+		}
+
+		auto deltas = std::make_unique<TComponentDeltas<T>>();
+		deltas->ids.Append(ids);
+		deltas->before.Reserve(ids.Size());
+		for (Id id : ids)
+		{
+			deltas->before.Add(hadValues ? CaptureValue<T>(ast, id) : std::nullopt);
+		}
+		return deltas;
+	}
+}    // namespace rift::AST
@@ -0,0 +1,173 @@
+// Copyright 2015-2023 Piperift - All rights reserved
+#pragma once
+
+#include "AST/Components/CDeclClass.h"
+#include "AST/Components/CDeclFunction.h"
+#include "AST/Components/CDeclNative.h"
+#include "AST/Components/CDeclStatic.h"
+#include "AST/Components/CDeclStruct.h"
+#include "AST/Components/CDeclType.h"
+#include "AST/Components/CDeclVariable.h"
+#include "AST/Components/CExprBinaryOperator.h"
+#include "AST/Components/CExprCall.h"
+#include "AST/Components/CExprDeclRef.h"
+#include "AST/Components/CExprInputs.h"
+#include "AST/Components/CExprOutputs.h"
+#include "AST/Components/CExprType.h"
+#include "AST/Components/CExprUnaryOperator.h"
+#include "AST/Components/CFileRef.h"
+#include "AST/Components/CLiteralBool.h"
+#include "AST/Components/CLiteralFloating.h"
+#include "AST/Components/CLiteralIntegral.h"
+#include "AST/Components/CLiteralString.h"
+#include "AST/Components/CModule.h"
+#include "AST/Components/CNamespace.h"
+#include "AST/Components/CStmtInput.h"
+#include "AST/Components/CStmtOutputs.h"
+#include "AST/Components/Views/CNodePosition.h"
+#include "AST/Id.h"
+
+#include <Pipe/PipeECS.h>
+
+#include <type_traits>
+
+
+namespace rift::AST
+{
+	/**
+	 * True for components known to store no entity ids. Tags are assumed to have none.
+	 * Components with values must be specialized here (or next to their registration), so that
+	 * new components can't be remapped without anyone checking their ids.
+	 */
+	template<typename T>
+	inline constexpr bool hasNoIds = std::is_empty_v<T>;
+
+	template<>
+	inline constexpr bool hasNoIds<CNamespace> = true;
+	template<>
+	inline constexpr bool hasNoIds<CFileRef> = true;
+	template<>
+	inline constexpr bool hasNoIds<CModule> = true;
+	template<>
+	inline constexpr bool hasNoIds<CDeclType> = true;
+	template<>
+	inline constexpr bool hasNoIds<CDeclFunction> = true;
+	template<>
+	inline constexpr bool hasNoIds<CDeclNative> = true;
+	template<>
+	inline constexpr bool hasNoIds<CDeclClass> = true;
+	template<>
+	inline constexpr bool hasNoIds<CDeclStruct> = true;
+	template<>
+	inline constexpr bool hasNoIds<CDeclStatic> = true;
+	template<>
+	inline constexpr bool hasNoIds<CExprBinaryOperator> = true;
+	template<>
+	inline constexpr bool hasNoIds<CExprUnaryOperator> = true;
+	template<>
+	inline constexpr bool hasNoIds<CExprCall> = true;
+	template<>
+	inline constexpr bool hasNoIds<CExprDeclRef> = true;
+	template<>
+	inline constexpr bool hasNoIds<CExprType> = true;
+	template<>
+	inline constexpr bool hasNoIds<CLiteralBool> = true;
+	template<>
+	inline constexpr bool hasNoIds<CLiteralFloating> = true;
+	template<>
+	inline constexpr bool hasNoIds<CLiteralIntegral> = true;
+	template<>
+	inline constexpr bool hasNoIds<CLiteralString> = true;
+	template<>
+	inline constexpr bool hasNoIds<CNodePosition> = true;
+
+
+	/**
+	 * Calls visitor with a reference to every entity id stored inside a component, so that ids
+	 * can be remapped when entities are recreated or renumbered.
+	 * New components storing ids must add their own overload here.
+	 */
+	template<typename T, typename Visitor>
+	void VisitIds(T& component, Visitor&& visitor)
+	{
+		static_assert(hasNoIds<T>,
+		    "Component may store ids. Add a VisitIds overload or specialize hasNoIds for it");
+	}
+
+	template<typename Visitor>
+	void VisitIds(CChild& component, Visitor&& visitor)
+	{
+		visitor(component.parent);
+	}
+	template<typename Visitor>
+	void VisitIds(CParent& component, Visitor&& visitor)
+	{
+		for (Id& id : component.children)
+		{
+			visitor(id);
+		}
+	}
+	template<typename Visitor>
+	void VisitIds(CDeclVariable& component, Visitor&& visitor)
+	{
+		visitor(component.typeId);
+	}
+	template<typename Visitor>
+	void VisitIds(CExprCallId& component, Visitor&& visitor)
+	{
+		visitor(component.functionId);
+	}
+	template<typename Visitor>
+	void VisitIds(CExprDeclRefId& component, Visitor&& visitor)
+	{
+		visitor(component.declarationId);
+	}
+	template<typename Visitor>
+	void VisitIds(CExprTypeId& component, Visitor&& visitor)
+	{
+		visitor(component.id);
+	}
+	template<typename Visitor>
+	void VisitIds(CExprInputs& component, Visitor&& visitor)
+	{
+		for (ExprOutput& output : component.linkedOutputs)
+		{
+			visitor(output.nodeId);
+			visitor(output.pinId);
+		}
+		for (Id& id : component.pinIds)
+		{
+			visitor(id);
+		}
+	}
+	template<typename Visitor>
+	void VisitIds(CExprOutputs& component, Visitor&& visitor)
+	{
+		for (Id& id : component.pinIds)
+		{
+			visitor(id);
+		}
+	}
+	template<typename Visitor>
+	void VisitIds(CStmtInput& component, Visitor&& visitor)
+	{
+		visitor(component.linkOutputNode);
+	}
+	template<typename Visitor>
+	void VisitIds(CStmtOutput& component, Visitor&& visitor)
+	{
+		visitor(component.linkInputNode);
+	}
+	template<typename Visitor>
+	void VisitIds(CStmtOutputs& component, Visitor&& visitor)
+	{
+		for (Id& id : component.pinIds)
+		{
+			visitor(id);
+		}
+		for (Id& id : component.linkInputNodes)
+		{
+			visitor(id);
+		}
+	}
+}    // namespace rift::AST
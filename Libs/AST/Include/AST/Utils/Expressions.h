@@ -15,10 +15,10 @@
 // NOTE: In expression graphs, the Link Id is the Input Pin Id
 namespace rift::AST
 {
-	bool CanConnectExpr(TAccessRef<CExprInputs, CExprOutputs, CExprTypeId> access,
+	bool CanConnectExpr(TAccessRef<CExprInputs, CExprOutputs, CExprTypeId, CChild> access,
 	    ExprOutput output, ExprInput input);
 
-	bool TryConnectExpr(TAccessRef<TWrite<CExprInputs>, CExprOutputs, CExprTypeId> access,
+	bool TryConnectExpr(TAccessRef<TWrite<CExprInputs>, CExprOutputs, CExprTypeId, CChild> access,
 	    ExprOutput output, ExprInput input);
 	// Disconnects a particular link. (Note: link ids are the same as input nodes)
 	bool DisconnectExpr(Tree& ast, ExprInput input);
@@ -31,6 +31,12 @@ namespace rift::AST
 	 */
 	void DisconnectAllExprDeep(Tree& ast, TView<const Id> ids, bool ignoreRoot = false);
 
+	/**
+	 * Clears cached reachability of expressions affected by changes in the links of some nodes
+	 * Must be called after editing CExprInputs::linkedOutputs directly
+	 */
+	void InvalidateExprReachability(p::EntityContext& ast, TView<const Id> nodeIds);
+
 	bool RemoveExprInputPin(TAccessRef<CExprInputs, TWrite<CInvalid>> access, ExprInput id);
 	bool RemoveExprOutputPin(TAccessRef<CExprOutputs, TWrite<CInvalid>> access, ExprOutput id);
 
@@ -0,0 +1,46 @@
+// Copyright 2015-2023 Piperift - All rights reserved
+#pragma once
+
+#include "AST/Statics/SHierarchy.h"
+#include "AST/Tree.h"
+
+#include <Pipe/PipeArrays.h>
+#include <Pipe/PipeECS.h>
+
+
+namespace rift::AST
+{
+	using HierarchyAccess = TAccessRef<TWrite<CChild>, TWrite<CParent>>;
+
+
+	/**
+	 * @return the flat hierarchy of the tree, rebuilding it if the hierarchy changed since the
+	 * last call. Many changes in a row (E.g: loading) cause a single rebuild.
+	 */
+	const SHierarchy& GetFlatHierarchy(Tree& ast);
+
+	// Marks the flat hierarchy for a rebuild. Called by the hooks of CChild and CParent
+	void InvalidateFlatHierarchy(Tree& ast);
+
+	/**
+	 * Appends all children of the entities, recursively and in depth-first order, so that the
+	 * subtree of each entity is contiguous. Ids inside the subtree of other ids are only added
+	 * once, as children of them.
+	 * Subtrees are copied from the flat hierarchy if it is up to date. Otherwise they are
+	 * walked directly, since rebuilding it costs as much as walking the whole tree.
+	 */
+	void GetAllChildren(Tree& ast, p::TView<const Id> ids, p::TArray<Id>& outChildrenIds);
+
+	/**
+	 * Attaches entities to a parent. If the flat hierarchy was up to date, the new subtrees are
+	 * inserted into it instead of invalidating it.
+	 * Entities already in a hierarchy are moved, which invalidates it.
+	 */
+	void AttachChildren(Tree& ast, Id parentId, p::TView<Id> childIds);
+
+	/**
+	 * Removes entities and all their children. If the flat hierarchy was up to date, their
+	 * ranges are removed from it instead of invalidating it.
+	 */
+	void RemoveWithChildren(HierarchyAccess access, p::TView<Id> ids);
+}    // namespace rift::AST
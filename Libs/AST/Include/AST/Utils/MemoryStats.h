@@ -0,0 +1,203 @@
+// Copyright 2015-2023 Piperift - All rights reserved
+#pragma once
+
+#include "AST/Components/CDeclType.h"
+#include "AST/Components/CExprCall.h"
+#include "AST/Components/CExprDeclRef.h"
+#include "AST/Components/CExprInputs.h"
+#include "AST/Components/CExprOutputs.h"
+#include "AST/Components/CExprType.h"
+#include "AST/Components/CFileRef.h"
+#include "AST/Components/CLiteralString.h"
+#include "AST/Components/CModule.h"
+#include "AST/Components/CNamespace.h"
+#include "AST/Components/CStmtOutputs.h"
+#include "AST/Tree.h"
+#include "AST/Utils/SmallArray.h"
+
+#include <Pipe/Core/Map.h>
+#include <Pipe/Core/String.h>
+#include <Pipe/Files/Paths.h>
+#include <Pipe/PipeArrays.h>
+#include <Pipe/PipeECS.h>
+#include <Pipe/Reflect/TypeId.h>
+
+#include <type_traits>
+
+
+namespace rift::AST
+{
+	struct PoolMemoryStats
+	{
+		p::TypeId typeId;
+		p::String name;
+		p::i32 count = 0;
+		// Bytes of the components themselves
+		p::sizet inlineBytes = 0;
+		// Bytes allocated by components (strings, arrays...). Approximate, see GetHeapBytes
+		p::sizet heapBytes = 0;
+		// Pools not registered for compaction have no known heap bytes
+		bool registered = false;
+	};
+
+	struct StaticMemoryStats
+	{
+		p::String name;
+		// Approximate, see GetHeapBytes
+		p::sizet bytes = 0;
+	};
+
+	struct TreeMemoryStats
+	{
+		p::TArray<PoolMemoryStats> pools;
+		p::TArray<StaticMemoryStats> statics;
+		// Global table of interned namespaces, shared by all trees
+		p::u32 namespaceCount   = 0;
+		p::sizet namespaceBytes = 0;
+		// Distinct tags used by the tree. Pipe doesn't expose its global tag table, so only
+		// the characters of these tags are counted
+		p::i32 tagCount   = 0;
+		p::sizet tagBytes = 0;
+
+
+		p::sizet GetPoolBytes() const;
+		p::sizet GetStaticBytes() const;
+	};
+
+
+	// True for types that don't allocate memory of their own
+	template<typename T>
+	inline constexpr bool hasNoHeapBytes = std::is_trivially_copyable_v<T>;
+
+	// Tags and namespaces are interned. Their tables are reported on their own
+	template<>
+	inline constexpr bool hasNoHeapBytes<p::Tag> = true;
+	template<>
+	inline constexpr bool hasNoHeapBytes<Namespace> = true;
+	template<>
+	inline constexpr bool hasNoHeapBytes<CNamespace> = true;
+	template<>
+	inline constexpr bool hasNoHeapBytes<CDeclType> = true;
+	template<>
+	inline constexpr bool hasNoHeapBytes<CExprCall> = true;
+	template<>
+	inline constexpr bool hasNoHeapBytes<CExprDeclRef> = true;
+	template<>
+	inline constexpr bool hasNoHeapBytes<CExprType> = true;
+
+
+	/**
+	 * Heap bytes owned by a value. Components allocating memory must add their own overload
+	 * (found by ADL), like with VisitIds.
+	 * Only strings and small arrays report their capacity. TArray and TMap don't expose it,
+	 * so they are counted from their element count, and map buckets are not counted. Results
+	 * are a lower bound, reported as approximate.
+	 */
+	template<typename T>
+	p::sizet GetHeapBytes(const T& value)
+	{
+		static_assert(hasNoHeapBytes<T>,
+		    "Type may allocate memory. Add a GetHeapBytes overload or specialize hasNoHeapBytes "
+		    "for it");
+		return 0;
+	}
+	template<typename StringType>
+	p::sizet GetStringHeapBytes(const StringType& value)
+	{
+		// Short strings are stored inside the string itself
+		const auto* data  = reinterpret_cast<const p::u8*>(value.data());
+		const auto* begin = reinterpret_cast<const p::u8*>(&value);
+		if (data >= begin && data < begin + sizeof(StringType))
+		{
+			return 0;
+		}
+		return (value.capacity() + 1) * sizeof(typename StringType::value_type);
+	}
+	inline p::sizet GetHeapBytes(const p::String& value)
+	{
+		return GetStringHeapBytes(value);
+	}
+	inline p::sizet GetHeapBytes(const p::Path& value)
+	{
+		return GetStringHeapBytes(value.native());
+	}
+	template<typename T>
+	p::sizet GetHeapBytes(const p::TArray<T>& value)
+	{
+		p::sizet bytes = value.Size() * sizeof(T);
+		if constexpr (!std::is_trivially_copyable_v<T>)
+		{
+			for (const T& item : value)
+			{
+				bytes += GetHeapBytes(item);
+			}
+		}
+		return bytes;
+	}
+	template<typename T, p::i32 InlineCapacity>
+	p::sizet GetHeapBytes(const TSmallArray<T, InlineCapacity>& value)
+	{
+		return value.IsInline() ? 0 : value.Capacity() * sizeof(T);
+	}
+	template<typename Key, typename Value>
+	p::sizet GetHeapBytes(const p::TMap<Key, Value>& value)
+	{
+		p::sizet bytes = value.Size() * (sizeof(Key) + sizeof(Value));
+		for (const auto& it : value)
+		{
+			bytes += GetHeapBytes(it.second);
+		}
+		return bytes;
+	}
+
+	inline p::sizet GetHeapBytes(const CParent& component)
+	{
+		return GetHeapBytes(component.children);
+	}
+	inline p::sizet GetHeapBytes(const CFileRef& component)
+	{
+		return GetHeapBytes(component.path);
+	}
+	inline p::sizet GetHeapBytes(const CModule& component)
+	{
+		return GetHeapBytes(component.dependencies);
+	}
+	inline p::sizet GetHeapBytes(const CLiteralString& component)
+	{
+		return GetHeapBytes(component.value);
+	}
+	inline p::sizet GetHeapBytes(const CExprInputs& component)
+	{
+		return GetHeapBytes(component.linkedOutputs) + GetHeapBytes(component.pinIds);
+	}
+	inline p::sizet GetHeapBytes(const CExprOutputs& component)
+	{
+		return GetHeapBytes(component.pinIds);
+	}
+	inline p::sizet GetHeapBytes(const CStmtOutputs& component)
+	{
+		return GetHeapBytes(component.pinIds) + GetHeapBytes(component.linkInputNodes);
+	}
+
+
+	template<typename T>
+	void GetPoolMemoryStats(Tree& ast, PoolMemoryStats& stats)
+	{
+		const p::TArray<Id> ids = FindAllIdsWith<T>(ast);
+		stats.count             = ids.Size();
+		stats.registered        = true;
+		if constexpr (!std::is_empty_v<T>)
+		{
+			stats.inlineBytes = ids.Size() * sizeof(T);
+			for (Id id : ids)
+			{
+				stats.heapBytes += GetHeapBytes(ast.Get<const T>(id));
+			}
+		}
+	}
+
+	TreeMemoryStats GetMemoryStats(Tree& ast);
+
+	// @return stats formatted as a JSON object
+	p::String MemoryStatsToJson(const TreeMemoryStats& stats);
+}    // namespace rift::AST
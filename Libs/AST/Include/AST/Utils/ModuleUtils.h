@@ -45,6 +45,8 @@ namespace rift::AST
 	bool CreateProject(Tree& ast, StringView path);
 	bool OpenProject(Tree& ast, StringView path);
 	void CloseProject(Tree& ast);
+	// Binds the systems used by project trees. Needed again on copies of a project
+	void InitProjectSystems(Tree& ast);
 
 	Id CreateModule(Tree& ast, StringView path);
 
@@ -6,6 +6,7 @@
 #include "AST/Id.h"
 
 #include <Pipe/Core/GenericEnums.h>
+#include <Pipe/Core/String.h>
 #include <Pipe/Math/Math.h>
 #include <Pipe/PipeECS.h>
 #include <Pipe/Reflect/EnumType.h>
@@ -13,8 +14,12 @@
 
 namespace rift::AST
 {
-	Namespace GetNamespace(p::TAccessRef<CNamespace, CChild, CModule> access, Id id);
-	Namespace GetParentNamespace(p::TAccessRef<CNamespace, CChild, CModule> access, Id id);
+	// Namespaces and full names of named entities are cached on SNamespaceCache when they change
+	using NamespaceAccess      = p::TAccessRef<CNamespace, CChild, CModule>;
+	using NamespaceCacheAccess = p::TAccessRef<CNamespace, CChild, CParent, CModule>;
+
+	Namespace GetNamespace(NamespaceAccess access, Id id);
+	Namespace GetParentNamespace(NamespaceAccess access, Id id);
 
 	/**
 	 * Find an id from a given namespace
@@ -28,8 +33,21 @@ namespace rift::AST
 
 	p::Tag GetName(p::TAccessRef<CNamespace> access, Id id);
 	p::Tag GetNameUnsafe(p::TAccessRef<CNamespace> access, Id id);
-	p::String GetFullName(
-	    p::TAccessRef<CNamespace, CChild, CModule> access, Id id, bool localNamespace = false);
+	// @return full name of an entity (E.g: "@Module.Type.Function")
+	p::Tag GetFullName(NamespaceAccess access, Id id, bool localNamespace = false);
+
+	/**
+	 * Resolves and caches the namespaces and full names of some entities and their children
+	 * Called automatically when entities are named or attached
+	 */
+	void CacheNamespaces(NamespaceCacheAccess access, p::TView<const Id> ids);
+	void CacheAllNamespaces(NamespaceCacheAccess access);
+
+	/**
+	 * Removes cached namespaces of some entities and their children
+	 * Called automatically when names or parents change
+	 */
+	void InvalidateNamespaceCache(p::TAccessRef<CParent, CModule> access, p::TView<const Id> ids);
 }    // namespace rift::AST
 
 
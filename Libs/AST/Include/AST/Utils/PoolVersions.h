@@ -0,0 +1,60 @@
+// Copyright 2015-2023 Piperift - All rights reserved
+#pragma once
+
+#include "AST/Statics/SPoolVersions.h"
+#include "AST/Tree.h"
+#include "AST/Utils/SystemScheduler.h"
+
+#include <atomic>
+
+
+namespace rift::AST
+{
+	// @return a version never returned before, so versions don't repeat after resets or copies
+	inline p::u64 NewPoolVersion()
+	{
+		static std::atomic<p::u64> lastVersion = 0;
+		return ++lastVersion;
+	}
+
+	/**
+	 * Starts tracking the version of a component pool. Tracked pools are bound once per tree
+	 * with its other hooks (see Tree::BindPoolVersions).
+	 */
+	template<typename T>
+	void TrackPoolVersion(Tree& ast)
+	{
+		auto increase = [](auto& ast, auto ids) {
+			CheckStaticWrite<SPoolVersions>();
+			if (auto* poolVersions = ast.template TryGetStatic<SPoolVersions>())
+			{
+				if (p::u64* version = poolVersions->versions.Find(p::GetTypeId<T>()))
+				{
+					*version = NewPoolVersion();
+				}
+				else
+				{
+					poolVersions->versions.Insert(p::GetTypeId<T>(), NewPoolVersion());
+				}
+			}
+		};
+		ast.OnAdd<T>().Bind(increase);
+		ast.OnRemove<T>().Bind(increase);
+		RegisterHookWrites<T, SPoolVersions>();
+	}
+
+	/**
+	 * @return version of a tracked component pool. It changes every time the component is added
+	 * or removed from an entity. Consumers can compare it with the last version they processed
+	 * to skip work when nothing changed. Edits of existing components are not counted.
+	 * 0 if the pool didn't change since the tree was created or reset.
+	 */
+	template<typename T>
+	p::u64 GetPoolVersion(Tree& ast)
+	{
+		CheckStaticRead<SPoolVersions>();
+		const auto& poolVersions = ast.GetOrSetStatic<SPoolVersions>();
+		const p::u64* version    = poolVersions.versions.Find(p::GetTypeId<T>());
+		return version ? *version : 0;
+	}
+}    // namespace rift::AST
@@ -0,0 +1,30 @@
+// Copyright 2015-2023 Piperift - All rights reserved
+#pragma once
+
+#include "AST/Id.h"
+
+#include <Pipe/PipeArrays.h>
+
+
+namespace rift::AST
+{
+	struct Tree;
+
+
+	/**
+	 * Finds all expressions referencing a declaration (calls to a function, references to a
+	 * variable or pins of a type). Cost is proportional to the number of references.
+	 * @param declId function, variable or type to find references to
+	 * @param outExprIds referencing expressions are appended here
+	 */
+	void FindReferences(Tree& ast, Id declId, p::TArray<Id>& outExprIds);
+	void FindReferences(Tree& ast, p::TView<const Id> declIds, p::TArray<Id>& outExprIds);
+
+	/**
+	 * Marks expressions to be reindexed after their referenced ids changed in place
+	 * Adding CExprCallId, CExprDeclRefId or CExprTypeId is tracked automatically
+	 * @param T component that changed. CExprCallId, CExprDeclRefId or CExprTypeId
+	 */
+	template<typename T>
+	void MarkReferencesChanged(Tree& ast, p::TView<const Id> exprIds);
+}    // namespace rift::AST
@@ -0,0 +1,458 @@
+// Copyright 2015-2023 Piperift - All rights reserved
+#pragma once
+
+#include <Pipe/Core/Checks.h>
+#include <Pipe/PipeArrays.h>
+#include <Pipe/Serialize/Serialization.h>
+
+#include <algorithm>
+#include <concepts>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+namespace rift::AST
+{
+	/**
+	 * Array storing its first InlineCapacity elements inside itself. Only grows into the heap
+	 * when the inline capacity is exceeded.
+	 * Made for small per-node lists (like pins) that are almost always tiny, avoiding one heap
+	 * allocation per component. Serializes exactly like a TArray, but can't be reflected since
+	 * reflection only knows TArray as a container.
+	 */
+	template<typename Type, p::i32 InlineCapacity = 4>
+	class TSmallArray
+	{
+		static_assert(InlineCapacity > 0, "Inline capacity must be greater than 0");
+
+		alignas(Type) p::u8 inlineData[sizeof(Type) * InlineCapacity];
+		Type* heapData  = nullptr;
+		p::i32 size     = 0;
+		p::i32 capacity = InlineCapacity;
+
+
+	public:
+		TSmallArray() = default;
+		explicit TSmallArray(p::i32 count, const Type& value = {})
+		{
+			Resize(count, value);
+		}
+		TSmallArray(p::TView<const Type> values)
+		{
+			Append(values);
+		}
+		TSmallArray(std::initializer_list<Type> values)
+		    : TSmallArray(p::TView<const Type>{values.begin(), p::i32(values.size())})
+		{}
+		TSmallArray(const TSmallArray& other)
+		{
+			Append(other);
+		}
+		TSmallArray(TSmallArray&& other) noexcept
+		{
+			MoveFrom(other);
+		}
+		TSmallArray& operator=(const TSmallArray& other)
+		{
+			if (this != &other)
+			{
+				Clear(false);
+				Append(other);
+			}
+			return *this;
+		}
+		TSmallArray& operator=(TSmallArray&& other) noexcept
+		{
+			if (this != &other)
+			{
+				Clear(true);
+				MoveFrom(other);
+			}
+			return *this;
+		}
+		~TSmallArray()
+		{
+			Clear(true);
+		}
+
+		p::i32 Add(Type&& value = {})
+		{
+			ReserveMore(1);
+			new (Data() + size) Type(std::move(value));
+			return size++;
+		}
+		p::i32 Add(const Type& value)
+		{
+			// Copy first. value may live inside this array and be invalidated by growing
+			Type copy(value);
+			return Add(std::move(copy));
+		}
+
+		void Append(p::TView<const Type> values)
+		{
+			ReserveMore(values.Size());
+			Type* data = Data();
+			for (const Type& value : values)
+			{
+				new (data + size++) Type(value);
+			}
+		}
+
+		void Insert(p::i32 index, Type&& value = {})
+		{
+			Check(index >= 0 && index <= size);
+			ReserveMore(1);
+			Type* data = Data();
+			if (index < size)
+			{
+				new (data + size) Type(std::move(data[size - 1]));
+				for (p::i32 i = size - 1; i > index; --i)
+				{
+					data[i] = std::move(data[i - 1]);
+				}
+				data[index] = std::move(value);
+			}
+			else
+			{
+				new (data + size) Type(std::move(value));
+			}
+			++size;
+		}
+		void Insert(p::i32 index, const Type& value)
+		{
+			Type copy(value);
+			Insert(index, std::move(copy));
+		}
+
+		void RemoveAt(p::i32 index, bool shouldShrink = true)
+		{
+			Check(IsValidIndex(index));
+			Type* data = Data();
+			for (p::i32 i = index; i < size - 1; ++i)
+			{
+				data[i] = std::move(data[i + 1]);
+			}
+			data[--size].~Type();
+			if (shouldShrink)
+			{
+				Shrink();
+			}
+		}
+
+		void Swap(p::i32 firstIndex, p::i32 secondIndex)
+		{
+			Check(IsValidIndex(firstIndex) && IsValidIndex(secondIndex));
+			if (firstIndex != secondIndex)
+			{
+				std::swap(Data()[firstIndex], Data()[secondIndex]);
+			}
+		}
+
+		void Resize(p::i32 count, const Type& value = {})
+		{
+			if (count > size)
+			{
+				Reserve(count);
+				Type* data = Data();
+				while (size < count)
+				{
+					new (data + size++) Type(value);
+				}
+			}
+			else
+			{
+				Type* data = Data();
+				while (size > count)
+				{
+					data[--size].~Type();
+				}
+			}
+		}
+
+		void Reserve(p::i32 newCapacity)
+		{
+			if (newCapacity > capacity)
+			{
+				Reallocate(newCapacity);
+			}
+		}
+		void ReserveMore(p::i32 count)
+		{
+			if (size + count > capacity)
+			{
+				// Grow geometrically like TArray
+				Reallocate(std::max(size + count, capacity * 2));
+			}
+		}
+
+		// Moves elements back into the inline storage if they fit
+		void Shrink()
+		{
+			if (heapData && size <= InlineCapacity)
+			{
+				Reallocate(InlineCapacity);
+			}
+		}
+
+		void Clear(bool shouldShrink = true)
+		{
+			Type* data = Data();
+			for (p::i32 i = 0; i < size; ++i)
+			{
+				data[i].~Type();
+			}
+			size = 0;
+			if (shouldShrink && heapData)
+			{
+				std::allocator<Type>{}.deallocate(heapData, capacity);
+				heapData = nullptr;
+				capacity = InlineCapacity;
+			}
+		}
+
+		p::i32 FindIndex(const Type& value) const
+		{
+			for (p::i32 i = 0; i < size; ++i)
+			{
+				if (Data()[i] == value)
+				{
+					return i;
+				}
+			}
+			return p::NO_INDEX;
+		}
+		template<typename Callback>
+		p::i32 FindIndex(Callback callback) const
+		    requires(std::is_invocable_r_v<bool, Callback, const Type&>)
+		{
+			for (p::i32 i = 0; i < size; ++i)
+			{
+				if (callback(Data()[i]))
+				{
+					return i;
+				}
+			}
+			return p::NO_INDEX;
+		}
+		bool Contains(const Type& value) const
+		{
+			return FindIndex(value) != p::NO_INDEX;
+		}
+		Type* Find(const Type& value)
+		{
+			const p::i32 index = FindIndex(value);
+			return index != p::NO_INDEX ? Data() + index : nullptr;
+		}
+		const Type* Find(const Type& value) const
+		{
+			const p::i32 index = FindIndex(value);
+			return index != p::NO_INDEX ? Data() + index : nullptr;
+		}
+		Type& FindRef(const Type& value)
+		{
+			Type* found = Find(value);
+			Check(found);
+			return *found;
+		}
+
+		// @return element at index or nullptr if out of bounds
+		Type* At(p::i32 index)
+		{
+			return IsValidIndex(index) ? Data() + index : nullptr;
+		}
+		const Type* At(p::i32 index) const
+		{
+			return IsValidIndex(index) ? Data() + index : nullptr;
+		}
+		Type& First()
+		{
+			Check(size > 0);
+			return Data()[0];
+		}
+		const Type& First() const
+		{
+			Check(size > 0);
+			return Data()[0];
+		}
+		Type& Last()
+		{
+			Check(size > 0);
+			return Data()[size - 1];
+		}
+		const Type& Last() const
+		{
+			Check(size > 0);
+			return Data()[size - 1];
+		}
+
+		p::i32 Size() const
+		{
+			return size;
+		}
+		p::i32 Capacity() const
+		{
+			return capacity;
+		}
+		bool IsEmpty() const
+		{
+			return size == 0;
+		}
+		bool IsValidIndex(p::i32 index) const
+		{
+			return index >= 0 && index < size;
+		}
+		// @return true if elements are stored inside the array
+		bool IsInline() const
+		{
+			return heapData == nullptr;
+		}
+
+		Type* Data()
+		{
+			return heapData ? heapData : reinterpret_cast<Type*>(inlineData);
+		}
+		const Type* Data() const
+		{
+			return heapData ? heapData : reinterpret_cast<const Type*>(inlineData);
+		}
+
+		Type& operator[](p::i32 index)
+		{
+			Check(IsValidIndex(index));
+			return Data()[index];
+		}
+		const Type& operator[](p::i32 index) const
+		{
+			Check(IsValidIndex(index));
+			return Data()[index];
+		}
+
+		Type* begin()
+		{
+			return Data();
+		}
+		const Type* begin() const
+		{
+			return Data();
+		}
+		Type* end()
+		{
+			return Data() + size;
+		}
+		const Type* end() const
+		{
+			return Data() + size;
+		}
+
+		operator p::TView<Type>()
+		{
+			return {Data(), size};
+		}
+		operator p::TView<const Type>() const
+		{
+			return {Data(), size};
+		}
+
+		bool operator==(const TSmallArray& other) const
+		    requires(std::equality_comparable<Type>)
+		{
+			if (size != other.size)
+			{
+				return false;
+			}
+			for (p::i32 i = 0; i < size; ++i)
+			{
+				if (!(Data()[i] == other.Data()[i]))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		void Read(p::Reader& ct)
+		{
+			p::u32 count = 0;
+			ct.BeginArray(count);
+			Clear(false);
+			Resize(p::i32(count));
+			for (p::u32 i = 0; i < count; ++i)
+			{
+				ct.Next(Data()[i]);
+			}
+		}
+		void Write(p::Writer& ct) const
+		{
+			p::u32 count = size;
+			ct.BeginArray(count);
+			for (p::u32 i = 0; i < count; ++i)
+			{
+				ct.Next(Data()[i]);
+			}
+		}
+
+	private:
+		void Reallocate(p::i32 newCapacity)
+		{
+			Type* oldData = Data();
+			Type* newData = newCapacity > InlineCapacity
+			                  ? std::allocator<Type>{}.allocate(newCapacity)
+			                  : reinterpret_cast<Type*>(inlineData);
+			if (newData != oldData)
+			{
+				for (p::i32 i = 0; i < size; ++i)
+				{
+					new (newData + i) Type(std::move(oldData[i]));
+					oldData[i].~Type();
+				}
+			}
+			if (heapData && heapData != newData)
+			{
+				std::allocator<Type>{}.deallocate(heapData, capacity);
+			}
+			heapData = newData != reinterpret_cast<Type*>(inlineData) ? newData : nullptr;
+			capacity = newCapacity;
+		}
+
+		void MoveFrom(TSmallArray& other)
+		{
+			if (other.heapData)
+			{
+				// Steal the heap allocation
+				heapData       = other.heapData;
+				size           = other.size;
+				capacity       = other.capacity;
+				other.heapData = nullptr;
+				other.size     = 0;
+				other.capacity = InlineCapacity;
+			}
+			else
+			{
+				Type* data      = Data();
+				Type* otherData = other.Data();
+				for (p::i32 i = 0; i < other.size; ++i)
+				{
+					new (data + i) Type(std::move(otherData[i]));
+					otherData[i].~Type();
+				}
+				size       = other.size;
+				other.size = 0;
+			}
+		}
+	};
+}    // namespace rift::AST
+
+
+namespace p
+{
+	template<typename Type, i32 InlineCapacity>
+	struct TFlags<rift::AST::TSmallArray<Type, InlineCapacity>> : public DefaultTFlags
+	{
+		enum
+		{
+			HasMemberSerialize = true
+		};
+	};
+}    // namespace p
@@ -0,0 +1,44 @@
+// Copyright 2015-2023 Piperift - All rights reserved
+#pragma once
+
+#include "AST/Tree.h"
+
+#include <Pipe/Memory/OwnPtr.h>
+
+
+namespace rift::AST
+{
+	/**
+	 * Copy of a tree owned by the tree it was taken from. It must only be read, and only until
+	 * the next snapshot replaces it or the tree is reset. Consumers on other threads must be
+	 * done by then (E.g: BuildService::Cancel waits until its build copied the snapshot).
+	 */
+	using TreeSnapshot = p::TPtr<Tree>;
+
+
+	/**
+	 * Takes a snapshot of the tree: a full copy, cached until the tree is edited. All callers
+	 * share the same copy until then, so only the first snapshot after an edit copies the tree.
+	 * Pools are not shared between the tree and its snapshot.
+	 * Consumers that need to modify it (E.g: the compiler) must copy the snapshot, preferably
+	 * from their own thread.
+	 */
+	TreeSnapshot TakeSnapshot(Tree& ast);
+
+	// @return the last snapshot if the tree wasn't edited after it, or null otherwise
+	TreeSnapshot FindSnapshot(Tree& ast);
+
+	/**
+	 * Marks the tree as edited, so that the next snapshot copies it again.
+	 * Called by transactions, undo and redo. Created and removed nodes and files are detected
+	 * from the pool versions of CChild and CFileRef. Call this after modifying the tree in any
+	 * other way.
+	 */
+	void MarkEdited(Tree& ast);
+
+	// @return true if the tree has been edited since this snapshot was taken
+	bool IsSnapshotOutdated(Tree& ast, const TreeSnapshot& snapshot);
+
+	// @return version of the tree that changes every time an edit is detected
+	p::u64 GetEditVersion(Tree& ast);
+}    // namespace rift::AST
@@ -49,7 +49,7 @@ namespace rift::AST
 	Id GetPreviousStmt(TAccessRef<CStmtInput> access, Id stmtId);
 	void GetPreviousStmts(
 	    TAccessRef<CStmtInput> access, TView<const Id> stmtIds, TArray<Id>& prevStmtIds);
-	TView<Id> GetNextStmts(TAccessRef<CStmtOutputs> access, Id stmtId);
+	TView<const Id> GetNextStmts(TAccessRef<CStmtOutputs> access, Id stmtId);
 	void GetNextStmts(
 	    TAccessRef<CStmtOutputs> access, TView<const Id> stmtIds, TArray<Id>& nextStmtIds);
 
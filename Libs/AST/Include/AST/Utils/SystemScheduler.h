@@ -0,0 +1,165 @@
+// Copyright 2015-2023 Piperift - All rights reserved
+#pragma once
+
+#include "AST/Tree.h"
+
+#include <Pipe/Core/Function.h>
+#include <Pipe/PipeArrays.h>
+#include <Pipe/PipeECS.h>
+#include <Pipe/Reflect/TypeId.h>
+
+
+namespace rift::AST
+{
+	// Components (or statics) read and written by a system
+	struct SystemAccess
+	{
+		p::TArray<p::TypeId> reads;
+		p::TArray<p::TypeId> writes;
+		// Systems taking the whole tree can touch anything. They never run in parallel
+		bool exclusive = false;
+
+
+		bool Conflicts(const SystemAccess& other) const;
+	};
+
+	/**
+	 * Registers types written when a component is added, removed or edited outside of the
+	 * accesses of a system (E.g: statics updated by its hooks). Systems writing the component
+	 * are scheduled as writers of them too. Call it where the hooks are bound.
+	 */
+	void RegisterHookWrites(p::TypeId type, p::TView<const p::TypeId> writes);
+	template<typename T, typename... Writes>
+	void RegisterHookWrites()
+	{
+		const p::TypeId writes[]{p::GetTypeId<Writes>()...};
+		RegisterHookWrites(p::GetTypeId<T>(), {writes, p::i32(sizeof...(Writes))});
+	}
+
+	// Adds the types written by hooks of the components an access writes
+	void AddHookWrites(SystemAccess& access);
+
+	/**
+	 * Checks that the system running on this thread declared a static it accesses, directly or
+	 * as a hook write of a component it writes. Call it where statics are read or written.
+	 * Accesses outside of systems and inside exclusive systems are always valid.
+	 * Only checked on debug builds.
+	 */
+#if P_DEBUG
+	void CheckStaticAccess(p::TypeId type, bool write);
+#else
+	inline void CheckStaticAccess(p::TypeId, bool) {}
+#endif
+	template<typename T>
+	void CheckStaticRead()
+	{
+		CheckStaticAccess(p::GetTypeId<T>(), false);
+	}
+	template<typename T>
+	void CheckStaticWrite()
+	{
+		CheckStaticAccess(p::GetTypeId<T>(), true);
+	}
+
+	template<typename T>
+	struct TSystemAccessType
+	{
+		static void Add(SystemAccess& access)
+		{
+			access.reads.Add(p::GetTypeId<T>());
+		}
+		static void AssurePool(Tree& ast)
+		{
+			ast.AssurePool<T>();
+		}
+	};
+	template<typename T>
+	struct TSystemAccessType<p::TWrite<T>>
+	{
+		static void Add(SystemAccess& access)
+		{
+			access.writes.Add(p::GetTypeId<T>());
+		}
+		static void AssurePool(Tree& ast)
+		{
+			ast.AssurePool<T>();
+		}
+	};
+
+
+	/**
+	 * Runs systems in order of addition, in parallel when their accesses don't conflict.
+	 * Read and write sets are deduced from the TAccessRef parameter of each system, plus the
+	 * hook writes registered for the components it writes and the statics it declares.
+	 * Systems taking Tree& are exclusive and act as barriers.
+	 */
+	struct SystemScheduler
+	{
+		struct System
+		{
+			p::StringView name;
+			SystemAccess access;
+			p::TFunction<void(Tree&)> run;
+			// Creates the pools used by the system before running in parallel
+			p::TFunction<void(Tree&)> assurePools;
+
+
+			// Declares statics read by the system. TAccessRef only declares components
+			template<typename... T>
+			System& Reads()
+			{
+				(access.reads.Add(p::GetTypeId<T>()), ...);
+				return *this;
+			}
+			// Declares statics written by the system, other than the hook writes of its components
+			template<typename... T>
+			System& Writes()
+			{
+				(access.writes.Add(p::GetTypeId<T>()), ...);
+				return *this;
+			}
+		};
+
+	private:
+		p::TArray<System> systems;
+		// Milliseconds each system took on the last run
+		p::TArray<float> times;
+
+
+	public:
+		template<typename... T>
+		System& Add(p::StringView name, void (*system)(p::TAccessRef<T...>))
+		{
+			System& entry = systems.AddRef({name});
+			(TSystemAccessType<T>::Add(entry.access), ...);
+			entry.run = [system](Tree& ast) {
+				system(ast);
+			};
+			entry.assurePools = [](Tree& ast) {
+				(TSystemAccessType<T>::AssurePool(ast), ...);
+			};
+			return entry;
+		}
+
+		System& Add(p::StringView name, void (*system)(Tree&))
+		{
+			System& entry          = systems.AddRef({name});
+			entry.access.exclusive = true;
+			entry.run              = system;
+			return entry;
+		}
+
+		void Run(Tree& ast);
+
+		p::TView<const System> GetSystems() const
+		{
+			return systems;
+		}
+
+		// @return time in milliseconds of each system on the last run. Same order as GetSystems
+		p::TView<const float> GetTimes() const
+		{
+			return times;
+		}
+	};
+}    // namespace rift::AST
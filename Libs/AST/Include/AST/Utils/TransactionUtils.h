@@ -5,6 +5,7 @@
 #include "AST/Components/CFileRef.h"
 #include "AST/Components/Tags/CChanged.h"
 #include "AST/Components/Tags/CDirty.h"
+#include "AST/Statics/SUndoHistory.h"
 
 #include <Pipe/PipeECS.h>
 
@@ -18,6 +19,11 @@ namespace rift::AST
 		struct Transaction
 		{
 			bool active = false;
+			Tree* ast   = nullptr;
+			// State of the touched entities before the change
+			UndoTransaction undo;
+			// Children of the touched entities before the change
+			TArray<Id> childIds;
 		};
 
 		struct ScopedTransaction
@@ -33,6 +39,25 @@ namespace rift::AST
 
 		bool PreChange(const TransactionAccess& access, TView<const Id> entityIds);
 		void PostChange();
+
+		/**
+		 * Undo and redo restore the components of the entities touched by a transaction (and
+		 * their parents) as they were before or after it. Cost is proportional to the number
+		 * of touched entities.
+		 * Only components registered with RegisterCompactedPools are restored.
+		 */
+		bool Undo(Tree& ast);
+		bool Redo(Tree& ast);
+		bool CanUndo(const Tree& ast);
+		bool CanRedo(const Tree& ast);
+		void ClearHistory(Tree& ast);
+
+		/**
+		 * Replaces the ids of a history moved into another tree (E.g: by compaction).
+		 * @param remap new ids of entities that still exist. Destroyed entities get ids that
+		 * are dead in the tree, so that undo recreates them.
+		 */
+		void RemapHistory(Tree& ast, SUndoHistory& history, TMap<Id, Id>& remap);
 	}    // namespace Transactions
 }    // namespace rift::AST
 
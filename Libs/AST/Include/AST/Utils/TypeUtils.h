@@ -17,6 +17,7 @@
 #include "AST/Components/Tags/CDirty.h"
 #include "AST/Tree.h"
 #include "AST/TypeRef.h"
+#include "AST/Utils/Compaction.h"
 
 #include <Pipe/PipeECS.h>
 
@@ -89,7 +90,7 @@ namespace rift::AST
 	Id FindChildByName(TAccessRef<CNamespace, CParent> access, Id ownerId, Tag functionName);
 
 	using RemoveAccess = TAccess<TWrite<CChanged>, TWrite<CFileDirty>, TWrite<CStmtInput>,
-	    TWrite<CStmtOutputs>, TWrite<CParent>, TWrite<CChild>, CFileRef>;
+	    TWrite<CStmtOutputs>, TWrite<CParent>, TWrite<CChild>, CFileRef, CExprInputs>;
 	void RemoveNodes(const RemoveAccess& access, TView<Id> ids);
 
 	bool CopyExpressionType(TAccessRef<TWrite<CExprTypeId>> access, Id sourcePinId, Id targetPinId);
@@ -105,6 +106,7 @@ namespace rift::AST
 	template<typename TagType>
 	void RegisterFileType(p::Tag typeId, RiftTypeSettings settings)
 	{
+		RegisterCompactedPools<TagType>();
 		RegisterFileType(
 		    {.id = typeId, .tagType = TagType::GetStaticType(), .settings = p::Move(settings)});
 	}
@@ -4,11 +4,14 @@
 
 #include "Compiler/CompilerConfig.h"
 
+#include <Pipe/Core/Function.h>
 #include <Pipe/Core/Profiler.h>
 #include <Pipe/Core/String.h>
 #include <Pipe/Reflect/Reflection.h>
 #include <Pipe/Reflect/Struct.h>
 
+#include <atomic>
+
 
 namespace rift
 {
@@ -32,6 +35,13 @@ namespace rift
 		CompilerConfig config;
 		TArray<CompileError> errors;
 
+		// Optional flag set from other threads to stop the build at the next stage
+		const std::atomic<bool>* cancelFlag = nullptr;
+		// Optional callback receiving the stages of the build as they start
+		p::TFunction<void(StringView)> onProgress;
+		// Optional callback receiving errors as they are added
+		p::TFunction<void(const CompileError&)> onError;
+
 
 	public:
 		Compiler(AST::Tree& ast, const CompilerConfig& config) : ast{ast}, config{config} {}
@@ -46,9 +56,17 @@ namespace rift
 		{
 			return errors.Size() > 0;
 		}
+
+		void ReportProgress(StringView stage);
+		bool IsCancelled() const
+		{
+			return cancelFlag && cancelFlag->load(std::memory_order_relaxed);
+		}
 	};
 
 
+	void Build(Compiler& compiler, TPtr<Backend> backend);
+
 	void Build(AST::Tree& tree, const CompilerConfig& config, TPtr<Backend> backend);
 
 	void Build(AST::Tree& ast, const CompilerConfig& config, ClassType* backendType);
@@ -2,12 +2,127 @@
 
 #include "AST/Components/CNamespace.h"
 
+#include <Pipe/Core/Checks.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+
 
 namespace rift::AST
 {
+	namespace
+	{
+	struct NamespaceEntry
+	{
+		p::u32 parent = 0;
+		p::sizet hash = 0;
+		// All scopes from the root to this namespace
+		p::TArray<p::Tag> scopes;
+		// Handles of child namespaces, sorted by their last scope
+		p::TArray<p::u32> children;
+	};
+
+	// Global table of interned namespaces. Entries are allocated in blocks that never move and
+	// don't change once published, so they can be read without locking. Lookups of interned
+	// namespaces only take a shared lock. Interning new ones takes it exclusively.
+	// Entries are never released, so a handle resolves to the same namespace for the whole run.
+	struct NamespaceTable
+	{
+		static constexpr p::u32 blockSize = 1024;
+		static constexpr p::u32 maxBlocks = 4096;
+
+		std::shared_mutex mutex;
+		std::atomic<p::u32> size = 0;
+		std::atomic<NamespaceEntry*> blocks[maxBlocks] = {};
+
+
+		NamespaceTable()
+		{
+			// Entry 0 is the empty namespace
+			blocks[0].store(new NamespaceEntry[blockSize], std::memory_order_release);
+			size.store(1, std::memory_order_release);
+		}
+		~NamespaceTable()
+		{
+			for (auto& block : blocks)
+			{
+				delete[] block.load(std::memory_order_relaxed);
+			}
+		}
+
+		NamespaceEntry& Get(p::u32 handle) const
+		{
+			return blocks[handle / blockSize].load(std::memory_order_acquire)[handle % blockSize];
+		}
+
+		p::u32 Find(const NamespaceEntry& parentEntry, p::Tag scope, p::i32& childIndex) const
+		{
+			const p::u32* first = parentEntry.children.Data();
+			const p::u32* last  = first + parentEntry.children.Size();
+			const p::u32* it =
+			    std::lower_bound(first, last, scope, [this](p::u32 child, p::Tag scope) {
+				    return Get(child).scopes.Last() < scope;
+			    });
+			childIndex = p::i32(it - first);
+			return (it != last && Get(*it).scopes.Last() == scope) ? *it : 0;
+		}
+
+		p::u32 FindOrAdd(p::u32 parent, p::Tag scope)
+		{
+			p::i32 childIndex = 0;
+			{    // Most scopes are already interned
+				std::shared_lock lock{mutex};
+				if (p::u32 handle = Find(Get(parent), scope, childIndex))
+				{
+					return handle;
+				}
+			}
+
+			std::unique_lock lock{mutex};
+			NamespaceEntry& parentEntry = Get(parent);
+			// Another thread may have interned it after the shared lock was released
+			if (p::u32 handle = Find(parentEntry, scope, childIndex))
+			{
+				return handle;
+			}
+
+			const p::u32 handle = size.load(std::memory_order_relaxed);
+			CheckMsg(handle < blockSize * maxBlocks, "Too many namespaces");
+			auto& block = blocks[handle / blockSize];
+			if (!block.load(std::memory_order_relaxed))
+			{
+				block.store(new NamespaceEntry[blockSize], std::memory_order_release);
+			}
+
+			NamespaceEntry& entry = block.load(std::memory_order_relaxed)[handle % blockSize];
+			entry.parent          = parent;
+			entry.scopes.Reserve(parentEntry.scopes.Size() + 1);
+			entry.scopes.Append(parentEntry.scopes);
+			entry.scopes.Add(scope);
+			const p::sizet scopeHash = std::hash<p::StringView>{}(scope.AsString());
+			const p::sizet seed      = parentEntry.hash;
+			entry.hash               = seed ^ (scopeHash + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+			parentEntry.children.Insert(childIndex, handle);
+
+			// Publishes the entry
+			size.store(handle + 1, std::memory_order_release);
+			return handle;
+		}
+	};
+
+	NamespaceTable& GetNamespaceTable()
+	{
+		static NamespaceTable table;
+		return table;
+	}
+	}    // namespace
+
+
 	Namespace::Namespace(p::StringView value)
 	{
-		p::i32 size          = 0;
+		auto& table          = GetNamespaceTable();
 		const p::TChar* last = value.data() + value.size();
 		const p::TChar* curr = value.data();
 
@@ -15,81 +130,77 @@ namespace rift::AST
 			++curr;
 
 		const p::TChar* scopeStart = curr;
-		while (curr != last && size < scopeCount)
+		while (curr != last)
 		{
 			if (*curr == '.')
 			{
-				scopes[size] = p::Tag{
-				    p::StringView{scopeStart, curr}
-                };
+				handle     = table.FindOrAdd(handle, p::Tag{p::StringView{scopeStart, curr}});
 				scopeStart = curr + 1;
-				++size;
 			}
 			++curr;
 		}
 
 		if (scopeStart < curr)    // Add last
 		{
-			scopes[size] = p::Tag{
-			    p::StringView{scopeStart, curr}
-            };
+			handle = table.FindOrAdd(handle, p::Tag{p::StringView{scopeStart, curr}});
 		}
 	}
 
-	bool Namespace::Equals(const Namespace& other) const
+	Namespace::Namespace(p::TView<const p::Tag> scopes)
 	{
-		for (p::i32 i = 0; i < scopeCount; ++i)
+		auto& table = GetNamespaceTable();
+		for (p::Tag scope : scopes)
 		{
-			const p::Tag scope      = scopes[i];
-			const p::Tag otherScope = other.scopes[i];
-			if (scope != otherScope)
-			{
-				return false;
-			}
-			else if (scope.IsNone() && otherScope.IsNone())
+			if (scope.IsNone())
 			{
-				return true;
+				break;
 			}
+			handle = table.FindOrAdd(handle, scope);
 		}
-		return true;
 	}
 
-	bool Namespace::IsEmpty() const
+	Namespace::Namespace(const Namespace& parent, p::Tag scope) : handle{parent.handle}
 	{
-		return First().IsNone();
+		if (!scope.IsNone())
+		{
+			handle = GetNamespaceTable().FindOrAdd(parent.handle, scope);
+		}
 	}
 
 	p::i32 Namespace::Size() const
 	{
-		p::i32 size = 0;
-		while (size < scopeCount && !scopes[size].IsNone())
+		return GetNamespaceTable().Get(handle).scopes.Size();
+	}
+
+	bool Namespace::Contains(const Namespace& other) const
+	{
+		const auto& table = GetNamespaceTable();
+		const p::i32 size = Size();
+		p::u32 current    = other.handle;
+		while (current != 0 && table.Get(current).scopes.Size() > size)
 		{
-			++size;
+			current = table.Get(current).parent;
 		}
-		return size;
+		return current == handle;
 	}
 
 	p::String Namespace::ToString(bool isLocal) const
 	{
+		const auto& scopes = GetNamespaceTable().Get(handle).scopes;
+
 		p::String ns;
 		if (!isLocal)
 		{
 			ns.append("@");
-			const p::Tag firstScope = scopes[0];
-			if (!firstScope.IsNone())
+			if (!scopes.IsEmpty())
 			{
-				ns.append(firstScope.AsString());
+				ns.append(scopes[0].AsString());
 				ns.append(".");
 			}
 		}
-		for (p::i32 i = 1; i < scopeCount; ++i)
+		for (p::i32 i = 1; i < scopes.Size(); ++i)
 		{
-			const p::Tag scope = scopes[i];
-			if (scope.IsNone())
-			{
-				break;
-			}
-			ns.append(scope.AsString());
+			ns.append(scopes[i].AsString());
 			ns.append(".");
 		}
 
@@ -100,24 +211,99 @@ namespace rift::AST
 		return p::Move(ns);
 	}
 
+	p::TView<const p::Tag> Namespace::GetScopes() const
+	{
+		return GetNamespaceTable().Get(handle).scopes;
+	}
+
+	Namespace Namespace::GetParent() const
+	{
+		Namespace parent;
+		parent.handle = GetNamespaceTable().Get(handle).parent;
+		return parent;
+	}
+
+	p::sizet Namespace::GetHash() const
+	{
+		return GetNamespaceTable().Get(handle).hash;
+	}
+
+	p::Tag Namespace::First() const
+	{
+		return (*this)[0];
+	}
+
+	p::Tag Namespace::Last() const
+	{
+		const auto& scopes = GetNamespaceTable().Get(handle).scopes;
+		return !scopes.IsEmpty() ? scopes.Last() : p::Tag::None();
+	}
+
+	p::Tag Namespace::operator[](p::i32 index) const
+	{
+		const auto& scopes = GetNamespaceTable().Get(handle).scopes;
+		return scopes.IsValidIndex(index) ? scopes[index] : p::Tag::None();
+	}
+
+	const p::Tag* Namespace::begin() const
+	{
+		return GetNamespaceTable().Get(handle).scopes.Data();
+	}
+
+	const p::Tag* Namespace::end() const
+	{
+		const auto& scopes = GetNamespaceTable().Get(handle).scopes;
+		return scopes.Data() + scopes.Size();
+	}
+
 	void Namespace::Read(p::Reader& ct)
 	{
+		auto& table = GetNamespaceTable();
+		handle      = 0;
+
 		p::u32 size = 0;
 		ct.BeginArray(size);
-		size = p::math::Min(size, p::u32(Namespace::scopeCount));
 		for (p::u32 i = 0; i < size; ++i)
 		{
-			ct.Next(scopes[i]);
+			p::Tag scope;
+			ct.Next(scope);
+			if (!scope.IsNone())
+			{
+				handle = table.FindOrAdd(handle, scope);
+			}
 		}
 	}
 
 	void Namespace::Write(p::Writer& ct) const
 	{
-		p::u32 size = Size();
+		const auto& scopes = GetNamespaceTable().Get(handle).scopes;
+		p::u32 size        = scopes.Size();
 		ct.BeginArray(size);
 		for (p::u32 i = 0; i < size; ++i)
 		{
 			ct.Next(scopes[i]);
 		}
 	}
+
+	p::u32 Namespace::GetTableSize()
+	{
+		return GetNamespaceTable().size.load();
+	}
+
+	p::sizet Namespace::GetTableBytes()
+	{
+		auto& table = GetNamespaceTable();
+		std::shared_lock lock{table.mutex};
+
+		const p::u32 size = table.size.load();
+		p::sizet bytes    = sizeof(NamespaceTable);
+		bytes += ((size + NamespaceTable::blockSize - 1) / NamespaceTable::blockSize)
+		       * NamespaceTable::blockSize * sizeof(NamespaceEntry);
+		for (p::u32 handle = 0; handle < size; ++handle)
+		{
+			const NamespaceEntry& entry = table.Get(handle);
+			bytes += entry.scopes.Size() * sizeof(p::Tag) + entry.children.Size() * sizeof(p::u32);
+		}
+		return bytes;
+	}
 }    // namespace rift::AST
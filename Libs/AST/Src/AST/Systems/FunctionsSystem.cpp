@@ -8,6 +8,8 @@
 #include "AST/Components/Tags/CChanged.h"
 #include "AST/Components/Tags/CDirty.h"
 #include "AST/Utils/Namespaces.h"
+#include "AST/Utils/References.h"
+#include "AST/Utils/SystemScheduler.h"
 #include "AST/Utils/TypeUtils.h"
 
 #include <Pipe/PipeECS.h>
@@ -35,6 +37,36 @@ namespace rift::AST::FunctionsSystem
 		ast.OnAdd<CExprCallId>().Bind([](auto& ast, auto ids) {
 			ast.template AddN<CCallDirty>(ids);
 		});
+
+		// Pins only need to be reordered when nodes are added or pins change validity
+		auto markPinsDirty = [](auto& ast, auto ids) {
+			ast.template AddN<CPinsDirty>(ids);
+		};
+		ast.OnAdd<CExprInputs>().Bind(markPinsDirty);
+		ast.OnAdd<CExprOutputs>().Bind(markPinsDirty);
+		auto markPinNodesDirty = [](auto& ast, auto ids) {
+			TArray<Id> nodeIds;
+			nodeIds.Reserve(ids.Size());
+			for (Id pinId : ids)
+			{
+				// Pins are either the node itself or one of its children
+				const bool isNode = ast.template Has<CExprInputs>(pinId)
+				                 || ast.template Has<CExprOutputs>(pinId);
+				const Id nodeId = isNode ? pinId : p::GetParent(ast, pinId);
+				// Pins removed with their node have no node to reorder
+				if (!IsNone(nodeId) && ast.IsValid(nodeId))
+				{
+					nodeIds.Add(nodeId);
+				}
+			}
+			ast.template AddN<CPinsDirty>(nodeIds);
+		};
+		ast.OnAdd<CInvalid>().Bind(markPinNodesDirty);
+		ast.OnRemove<CInvalid>().Bind(markPinNodesDirty);
+		RegisterHookWrites<CExprCallId, CCallDirty>();
+		RegisterHookWrites<CExprInputs, CPinsDirty>();
+		RegisterHookWrites<CExprOutputs, CPinsDirty>();
+		RegisterHookWrites<CInvalid, CPinsDirty>();
 	}
 
 	void ResolveCallFunctionIds(
@@ -62,21 +94,28 @@ namespace rift::AST::FunctionsSystem
 			return;
 		}
 
-		TArray<Id> callExprIds = FindAllIdsWith<CExprCallId>(access);
-		ExcludeIdsWith<CCallDirty>(access, callExprIds);
-		for (Id id : callExprIds)
+		// Only visit calls referencing changed declarations
+		TArray<Id> referenceIds;
+		FindReferences(ast, FindAllIdsWith<CChanged>(access), referenceIds);
+		for (Id id : FindIdsWith<CExprCallId>(access, referenceIds))
 		{
 			const Id functionId = access.Get<const CExprCallId>(id).functionId;
-			if (!IsNone(functionId) && access.Has<CChanged>(functionId))
+			if (access.Has<CChanged>(functionId) && !access.Has<CCallDirty>(id))
 			{
 				access.Add<CCallDirty>(id);
 			}
 		}
 	}
 
-	void PushInvalidPinsBack(TAccessRef<TWrite<CExprInputs>, TWrite<CExprOutputs>, CInvalid> access)
+	void PushInvalidPinsBack(PushInvalidPinsAccess access)
 	{
-		for (Id inputsId : FindAllIdsWith<CExprInputs>(access))
+		const TArray<Id> dirtyIds = FindAllIdsWith<CPinsDirty>(access);
+		if (dirtyIds.IsEmpty())
+		{
+			return;
+		}
+
+		for (Id inputsId : FindIdsWith<CExprInputs>(access, dirtyIds))
 		{
 			auto& inputs  = access.Get<CExprInputs>(inputsId);
 			i32 validSize = inputs.pinIds.Size();
@@ -99,7 +138,7 @@ namespace rift::AST::FunctionsSystem
 			}
 		}
 
-		for (Id outputsId : FindAllIdsWith<CExprOutputs>(access))
+		for (Id outputsId : FindIdsWith<CExprOutputs>(access, dirtyIds))
 		{
 			auto& outputs = access.Get<CExprOutputs>(outputsId);
 			i32 validSize = outputs.pinIds.Size();
@@ -118,6 +157,8 @@ namespace rift::AST::FunctionsSystem
 				}
 			}
 		}
+
+		access.Remove<CPinsDirty>(dirtyIds);
 	}
 
 	void SyncCallPinsFromFunction(Tree& ast)
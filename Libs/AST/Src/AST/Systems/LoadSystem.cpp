@@ -12,6 +12,7 @@
 #include "AST/Statics/SModules.h"
 #include "AST/Statics/SStringLoad.h"
 #include "AST/Statics/STypes.h"
+#include "AST/Utils/Hierarchy.h"
 #include "AST/Utils/ModuleIterator.h"
 #include "AST/Utils/ModuleUtils.h"
 #include "AST/Utils/TypeIterator.h"
@@ -154,7 +155,7 @@ namespace rift::AST::LoadSystem
 
 		// Link modules to the project
 		const Id projectId = GetProjectId(access);
-		p::Attach(access, projectId, ids);
+		AttachChildren(ast, projectId, ids);
 	}
 
 	void CreateTypesFromPaths(Tree& ast, TView<ModuleTypePaths> pathsByModule, TArray<Id>& ids)
@@ -191,7 +192,7 @@ namespace rift::AST::LoadSystem
 				ast.Add(id, CFileRef{Move(path)});
 			}
 
-			p::Attach(ast, modulePaths.moduleId, typeIds);
+			AttachChildren(ast, modulePaths.moduleId, typeIds);
 			ids.Append(typeIds);
 		}
 	}
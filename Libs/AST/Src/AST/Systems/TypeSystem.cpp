@@ -8,6 +8,8 @@
 #include "AST/Statics/STypes.h"
 #include "AST/Tree.h"
 #include "AST/Utils/Namespaces.h"
+#include "AST/Utils/References.h"
+#include "AST/Utils/SystemScheduler.h"
 #include "AST/Utils/TypeUtils.h"
 
 #include <Pipe/PipeECS.h>
@@ -20,6 +22,7 @@ namespace rift::AST::TypeSystem
 		TAccess<CDeclType, CNamespace> access{ast};
 
 		ast.OnAdd<CFileRef>().Bind([](auto& ast, auto ids) {
+			CheckStaticWrite<STypes>();
 			auto& types = ast.template GetOrSetStatic<STypes>();
 			for (Id id : ids)
 			{
@@ -31,7 +34,12 @@ namespace rift::AST::TypeSystem
 			}
 		});
 
+		ast.OnAdd<CExprDeclRefId>().Bind([](auto& ast, auto ids) {
+			ast.template AddN<CDeclRefDirty>(ids);
+		});
+
 		ast.OnRemove<CFileRef>().Bind([](auto& ast, auto ids) {
+			CheckStaticWrite<STypes>();
 			auto& types = ast.template GetOrSetStatic<STypes>();
 			for (Id id : ids)
 			{
@@ -42,19 +50,35 @@ namespace rift::AST::TypeSystem
 				}
 			}
 		});
+		RegisterHookWrites<CFileRef, STypes>();
+		RegisterHookWrites<CExprDeclRefId, CDeclRefDirty>();
 	}
 
 	void PropagateVariableTypes(PropagateVariableTypesAccess access)
 	{
-		for (Id id : FindAllIdsWith<CExprDeclRefId>(access))
+		TArray<Id> dirtyIds = FindAllIdsWith<CDeclRefDirty, CExprDeclRefId>(access);
+		for (i32 i = dirtyIds.Size() - 1; i >= 0; --i)
 		{
+			const Id id     = dirtyIds[i];
 			const Id declId = access.Get<const CExprDeclRefId>(id).declarationId;
 			if (access.IsValid(declId))
 			{
 				const Id typeId = access.Get<const CDeclVariable>(declId).typeId;
 				access.Add<CExprTypeId>(id, {.id = typeId});
 			}
+			else    // Keep dirty until the declaration is valid
+			{
+				dirtyIds.RemoveAtSwapUnsafe(i);
+			}
 		}
+		access.Remove<CDeclRefDirty>(dirtyIds);
+	}
+
+	void MarkVariableRefsDirty(Tree& ast, Id variableId)
+	{
+		TArray<Id> referenceIds;
+		FindReferences(ast, variableId, referenceIds);
+		ast.AddN<CDeclRefDirty>(FindIdsWith<CExprDeclRefId>(ast, referenceIds));
 	}
 
 	bool PropagateUnaryOperator(TAccess<CExprInputs, TWrite<CExprTypeId>> access, Id nodeId)
@@ -100,36 +124,97 @@ namespace rift::AST::TypeSystem
 			return !access.Has<CExprUnaryOperator>(id) && !access.Has<CExprBinaryOperator>(id);
 		});
 
-		bool anyPropagated;
-		while (!dirtyNodeIds.IsEmpty())    // Repeat until nothing to propagate
+		if (dirtyNodeIds.IsEmpty())
 		{
-			bool anyPropagated = false;
-			// Propagate all dirty nodes, remove successfully propagated ones
-			for (i32 i = dirtyNodeIds.Size() - 1; i >= 0; --i)
-			{
-				const Id nodeId = dirtyNodeIds[i];
+			return;
+		}
+		// Sorted to find nodes by binary search
+		dirtyNodeIds.Sort([](Id one, Id other) {
+			return one < other;
+		});
 
-				if (access.Has<CExprUnaryOperator>(nodeId))
+		// Build the dependency graph between dirty nodes from their linked inputs
+		const i32 nodeCount = dirtyNodeIds.Size();
+		TArray<TArray<i32>> consumers;
+		consumers.Resize(nodeCount);
+		TArray<i32> pendingProducers;
+		pendingProducers.Resize(nodeCount, 0);
+		for (i32 i = 0; i < nodeCount; ++i)
+		{
+			const auto& inputs = access.Get<const CExprInputs>(dirtyNodeIds[i]);
+			for (const ExprOutput& output : inputs.linkedOutputs)
+			{
+				const i32 producer =
+				    output.IsNone() ? NO_INDEX : dirtyNodeIds.FindSortedEqual(output.nodeId);
+				if (producer != NO_INDEX && producer != i)
 				{
-					if (PropagateUnaryOperator(access, nodeId))
-					{
-						dirtyNodeIds.RemoveAtSwapUnsafe(i);
-						anyPropagated = true;
-					}
+					consumers[producer].Add(i);
+					++pendingProducers[i];
 				}
-				else if (access.Has<CExprBinaryOperator>(nodeId))
+			}
+		}
+
+		auto propagate = [&access, &dirtyNodeIds](i32 index) {
+			const Id nodeId = dirtyNodeIds[index];
+			if (access.Has<CExprUnaryOperator>(nodeId))
+			{
+				return PropagateUnaryOperator(access, nodeId);
+			}
+			return PropagateBinaryOperator(access, nodeId);
+		};
+
+		// Visit nodes in topological order so that producers are propagated before consumers.
+		// Every node is propagated since a new link into an unchanged producer changes its types
+		TArray<i32> worklist;
+		worklist.Reserve(nodeCount);
+		for (i32 i = 0; i < nodeCount; ++i)
+		{
+			if (pendingProducers[i] == 0)
+			{
+				worklist.Add(i);
+			}
+		}
+		i32 visitedCount = 0;
+		while (!worklist.IsEmpty())
+		{
+			const i32 index = worklist.Last();
+			worklist.RemoveAt(worklist.Size() - 1, false);
+			++visitedCount;
+
+			propagate(index);
+			for (i32 consumer : consumers[index])
+			{
+				if (--pendingProducers[consumer] == 0)
 				{
-					if (PropagateBinaryOperator(access, nodeId))
-					{
-						dirtyNodeIds.RemoveAtSwapUnsafe(i);
-						anyPropagated = true;
-					}
+					worklist.Add(consumer);
 				}
 			}
+		}
 
-			if (!anyPropagated)    // If nothing propagated, there is nothing else we can do
+		if (visitedCount < nodeCount)
+		{
+			// Nodes left with pending producers are in (or after) a cycle. Links should prevent
+			// cycles, but loaded files may contain them. Propagate until their types are stable,
+			// with a pass per node at most, since each pass fixes at least one node in a chain
+			TArray<i32> cyclicIndices;
+			for (i32 i = 0; i < nodeCount; ++i)
 			{
-				break;
+				if (pendingProducers[i] > 0)
+				{
+					cyclicIndices.Add(i);
+				}
+			}
+			for (i32 pass = 0; pass < cyclicIndices.Size(); ++pass)
+			{
+				bool changed = false;
+				for (i32 index : cyclicIndices)
+				{
+					changed |= propagate(index);
+				}
+				if (!changed)
+				{
+					break;
+				}
 			}
 		}
 	}
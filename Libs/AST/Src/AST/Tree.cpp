@@ -4,13 +4,30 @@
 
 #include "AST/Components/CDeclNative.h"
 #include "AST/Components/CDeclType.h"
+#include "AST/Components/CFileRef.h"
+#include "AST/Components/CExprCall.h"
+#include "AST/Components/CExprDeclRef.h"
+#include "AST/Components/CExprInputs.h"
+#include "AST/Components/CExprType.h"
+#include "AST/Components/CModule.h"
 #include "AST/Components/CNamespace.h"
+#include "AST/Statics/SExprReachability.h"
+#include "AST/Statics/SHierarchy.h"
 #include "AST/Statics/SModules.h"
+#include "AST/Statics/SNamespaceCache.h"
+#include "AST/Statics/SReferences.h"
 #include "AST/Statics/STypes.h"
+#include "AST/Utils/Expressions.h"
+#include "AST/Utils/Hierarchy.h"
+#include "AST/Utils/Namespaces.h"
+#include "AST/Utils/PoolVersions.h"
+#include "AST/Utils/References.h"
+#include "AST/Utils/SystemScheduler.h"
 
 #include <Pipe/PipeECS.h>
 
 
+
 namespace rift::AST
 {
 	TBroadcast<Tree&> Tree::onInit{};
@@ -19,27 +36,32 @@ namespace rift::AST
 	Tree::Tree()
 	{
 		SetupNativeTypes();
+		BindHooks();
 		onInit(*this);
 	}
 
 	Tree::Tree(const Tree& other) noexcept : EntityContext(other)
 	{
 		CopyFrom(other);
+		BindHooks();
 	}
 	Tree::Tree(Tree&& other) noexcept : EntityContext(Move(other))
 	{
 		MoveFrom(Move(other));
+		BindHooks();
 	}
 	Tree& Tree::operator=(const Tree& other) noexcept
 	{
 		EntityContext::operator=(other);
 		CopyFrom(other);
+		BindHooks();
 		return *this;
 	}
 	Tree& Tree::operator=(Tree&& other) noexcept
 	{
 		EntityContext::operator=(Move(other));
 		MoveFrom(Move(other));
+		BindHooks();
 		return *this;
 	}
 
@@ -102,6 +124,96 @@ namespace rift::AST
 		Add(nativeTypes.stringId, CNamespace{"String"});
 	}
 
+	void Tree::BindHooks()
+	{
+		// Pools of copies don't keep the hooks of the original tree. All hooks are idempotent,
+		// so binding them again is safe either way
+		BindNamespaceCache();
+		BindReferenceIndex();
+		BindExprReachability();
+		BindHierarchy();
+		BindPoolVersions();
+	}
+
+	void Tree::BindNamespaceCache()
+	{
+		// Cached namespaces of the other tree may not match after an assignment
+		SetStatic<SNamespaceCache>();
+		CacheAllNamespaces(*this);
+
+		// Names change with their own or any parent's namespace and hierarchy
+		auto cache = [](auto& ast, auto ids) {
+			CacheNamespaces(static_cast<Tree&>(ast), ids);
+		};
+		auto invalidate = [](auto& ast, auto ids) {
+			InvalidateNamespaceCache(static_cast<Tree&>(ast), ids);
+		};
+		OnAdd<CNamespace>().Bind(cache);
+		OnRemove<CNamespace>().Bind(invalidate);
+		OnAdd<CChild>().Bind(cache);
+		OnRemove<CChild>().Bind(invalidate);
+		OnAdd<CModule>().Bind(cache);
+		OnRemove<CModule>().Bind(invalidate);
+		RegisterHookWrites<CNamespace, SNamespaceCache>();
+		RegisterHookWrites<CChild, SNamespaceCache>();
+		RegisterHookWrites<CModule, SNamespaceCache>();
+	}
+
+	void Tree::BindReferenceIndex()
+	{
+		OnAdd<CExprCallId>().Bind([](auto& ast, auto ids) {
+			MarkReferencesChanged<CExprCallId>(static_cast<Tree&>(ast), ids);
+		});
+		OnAdd<CExprDeclRefId>().Bind([](auto& ast, auto ids) {
+			MarkReferencesChanged<CExprDeclRefId>(static_cast<Tree&>(ast), ids);
+		});
+		OnAdd<CExprTypeId>().Bind([](auto& ast, auto ids) {
+			MarkReferencesChanged<CExprTypeId>(static_cast<Tree&>(ast), ids);
+		});
+		RegisterHookWrites<CExprCallId, SReferences>();
+		RegisterHookWrites<CExprDeclRefId, SReferences>();
+		RegisterHookWrites<CExprTypeId, SReferences>();
+	}
+
+	void Tree::BindExprReachability()
+	{
+		// Adding or removing nodes can break or restore links in any graph
+		auto invalidate = [](auto& ast, auto ids) {
+			InvalidateExprReachability(ast, ids);
+		};
+		OnAdd<CExprInputs>().Bind(invalidate);
+		OnRemove<CExprInputs>().Bind(invalidate);
+		OnRemove<CExprOutputs>().Bind(invalidate);
+		RegisterHookWrites<CExprInputs, SExprReachability>();
+		RegisterHookWrites<CExprOutputs, SExprReachability>();
+	}
+
+	void Tree::BindHierarchy()
+	{
+		// The flat hierarchy of the other tree is rebuilt on the next query
+		SetStatic<SHierarchy>();
+
+		auto invalidate = [](auto& ast, auto ids) {
+			InvalidateFlatHierarchy(static_cast<Tree&>(ast));
+		};
+		OnAdd<CChild>().Bind(invalidate);
+		OnRemove<CChild>().Bind(invalidate);
+		OnAdd<CParent>().Bind(invalidate);
+		OnRemove<CParent>().Bind(invalidate);
+		RegisterHookWrites<CChild, SHierarchy>();
+		RegisterHookWrites<CParent, SHierarchy>();
+	}
+
+	void Tree::BindPoolVersions()
+	{
+		SetStatic<SPoolVersions>();
+		// Pools checked for changes by the editor and snapshots
+		TrackPoolVersion<CNamespace>(*this);
+		TrackPoolVersion<CFileRef>(*this);
+		TrackPoolVersion<CParent>(*this);
+		TrackPoolVersion<CChild>(*this);
+	}
+
 	void Tree::CopyFrom(const Tree& other)
 	{
 		// Copy non-transient unique components
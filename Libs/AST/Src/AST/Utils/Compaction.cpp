@@ -0,0 +1,288 @@
+// Copyright 2015-2023 Piperift - All rights reserved
+
+#include "AST/Utils/Compaction.h"
+
+#include "AST/Components/CDeclFunction.h"
+#include "AST/Components/CDeclNative.h"
+#include "AST/Components/CDeclType.h"
+#include "AST/Components/CDeclVariable.h"
+#include "AST/Components/CExprBinaryOperator.h"
+#include "AST/Components/CExprCall.h"
+#include "AST/Components/CExprDeclRef.h"
+#include "AST/Components/CExprInputs.h"
+#include "AST/Components/CExprOutputs.h"
+#include "AST/Components/CExprType.h"
+#include "AST/Components/CExprUnaryOperator.h"
+#include "AST/Components/CFileRef.h"
+#include "AST/Components/CLiteralBool.h"
+#include "AST/Components/CLiteralFloating.h"
+#include "AST/Components/CLiteralIntegral.h"
+#include "AST/Components/CLiteralString.h"
+#include "AST/Components/CModule.h"
+#include "AST/Components/CNamespace.h"
+#include "AST/Components/CProject.h"
+#include "AST/Components/CStmtFor.h"
+#include "AST/Components/CStmtIf.h"
+#include "AST/Components/CStmtInput.h"
+#include "AST/Components/CStmtOutputs.h"
+#include "AST/Components/CStmtReturn.h"
+#include "AST/Components/Tags/CChanged.h"
+#include "AST/Components/Tags/CDirty.h"
+#include "AST/Components/Tags/CInvalid.h"
+#include "AST/Components/Tags/CPendingLoad.h"
+#include "AST/Components/Views/CNodePosition.h"
+#include "AST/Statics/SLoadQueue.h"
+#include "AST/Statics/SModules.h"
+#include "AST/Statics/SReferences.h"
+#include "AST/Statics/SStringLoad.h"
+#include "AST/Statics/STypes.h"
+#include "AST/Statics/SUndoHistory.h"
+#include "AST/Systems/FunctionsSystem.h"
+#include "AST/Utils/Hierarchy.h"
+#include "AST/Utils/ModuleUtils.h"
+#include "AST/Utils/TransactionUtils.h"
+
+#include <Pipe/Core/Checks.h>
+#include <Pipe/Core/Log.h>
+#include <Pipe/Core/Profiler.h>
+
+
+namespace rift::AST
+{
+	void RemapStaticIds(TArray<Id>& ids, const IdRemap& remap)
+	{
+		for (Id& id : ids)
+		{
+			id = remap.Get(id);
+		}
+	}
+
+	void RemapStaticIds(TMap<Tag, Id>& ids, const IdRemap& remap)
+	{
+		for (auto& it : ids)
+		{
+			it.second = remap.Get(it.second);
+		}
+	}
+
+	void RemapStaticIds(SModules& modules, const IdRemap& remap)
+	{
+		RemapStaticIds(modules.modulesByPath, remap);
+	}
+
+	void RemapStaticIds(STypes& types, const IdRemap& remap)
+	{
+		RemapStaticIds(types.typesByName, remap);
+		RemapStaticIds(types.typesByPath, remap);
+	}
+
+	void RemapStaticIds(SLoadQueue& loadQueue, const IdRemap& remap)
+	{
+		RemapStaticIds(loadQueue.pendingSyncLoad, remap);
+		RemapStaticIds(loadQueue.pendingAsyncLoad, remap);
+	}
+
+	void RemapStaticIds(SStringLoad& stringLoad, const IdRemap& remap)
+	{
+		RemapStaticIds(stringLoad.entities, remap);
+	}
+
+	void RemapStaticIds(SReferences& references, const IdRemap& remap)
+	{
+		auto remapExprs = [&remap](TArray<Id>& ids) {
+			RemapStaticIds(ids, remap);
+			ids.RemoveIf([](Id id) {
+				return IsNone(id);
+			});
+		};
+
+		TMap<Id, TArray<Id>> exprsByDecl;
+		for (auto& it : references.exprsByDecl)
+		{
+			const Id declId = remap.Get(it.first);
+			if (IsNone(declId))
+			{
+				continue;
+			}
+			TArray<Id> exprIds = Move(it.second);
+			remapExprs(exprIds);
+			exprIds.Sort([](Id one, Id other) {
+				return one < other;
+			});
+			exprsByDecl.Insert(declId, Move(exprIds));
+		}
+		references.exprsByDecl = Move(exprsByDecl);
+		remapExprs(references.pendingCallExprs);
+		remapExprs(references.pendingDeclRefExprs);
+		remapExprs(references.pendingTypeExprs);
+	}
+
+	void MoveUndoHistory(Tree& source, Tree& target, const IdRemap& remap)
+	{
+		if (auto* history = source.TryGetStatic<SUndoHistory>())
+		{
+			target.SetStatic<SUndoHistory>(Move(*history));
+			TMap<Id, Id> liveIds;
+			for (i32 i = 0; i < remap.oldIds.Size(); ++i)
+			{
+				if (!IsNone(remap.newIds[i]))
+				{
+					liveIds.Insert(remap.oldIds[i], remap.newIds[i]);
+				}
+			}
+			Transactions::RemapHistory(target, target.GetStatic<SUndoHistory>(), liveIds);
+		}
+	}
+
+
+	TArray<CompactedPool>& GetCompactedPools()
+	{
+		static TArray<CompactedPool> pools;
+		static bool registeredAST = false;
+		if (!registeredAST)
+		{
+			registeredAST = true;
+			RegisterCompactedPools<CChild, CParent, CProject, CModule, CFileRef, CNamespace,
+			    CDeclType, CDeclNative, CDeclVariable, CDeclFunction, CExprBinaryOperator,
+			    CExprUnaryOperator, CExprCall, CExprCallId, CExprDeclRef, CExprDeclRefId,
+			    CExprType, CExprTypeId, CExprInputs, CExprOutputs, CStmtInput, CStmtOutput,
+			    CStmtOutputs, CStmtIf, CStmtFor, CStmtReturn, CLiteralBool, CLiteralFloating,
+			    CLiteralIntegral, CLiteralString, CNodePosition, CInvalid>();
+			RegisterUntrackedPools<CPendingLoad, CDirty, CFileDirty, CCallDirty, CPinsDirty,
+			    CDeclRefDirty>();
+			RegisterTransientPools<CChanged, FunctionsSystem::CTmpInvalidKeep>();
+		}
+		return pools;
+	}
+
+	TArray<CompactedStatic>& GetCompactedStatics()
+	{
+		static TArray<CompactedStatic> statics;
+		static bool registeredAST = false;
+		if (!registeredAST)
+		{
+			registeredAST = true;
+			RegisterCompactedStatics<SModules, STypes, SLoadQueue, SStringLoad, SReferences>();
+			statics.Add({p::GetTypeId<SUndoHistory>(), &MoveUndoHistory});
+		}
+		return statics;
+	}
+
+	const CompactedPool* FindCompactedPool(p::TypeId typeId)
+	{
+		for (const CompactedPool& pool : GetCompactedPools())
+		{
+			if (pool.typeId == typeId)
+			{
+				return &pool;
+			}
+		}
+		return nullptr;
+	}
+
+	bool CanCompact(Tree& ast)
+	{
+		for (const auto& poolInstance : ast.GetPools())
+		{
+			if (poolInstance.GetPool()->Size() > 0 && !FindCompactedPool(poolInstance.componentId))
+			{
+				// Components of unregistered pools would be lost silently
+#if P_DEBUG
+				CheckMsg(false,
+				    "Can't compact tree: A component pool is not registered for compaction");
+#else
+				p::Warning(
+				    "Can't compact tree: A component pool is not registered for compaction");
+#endif
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void AddToRemap(IdRemap& remap, Id oldId, Id newId)
+	{
+		const i32 index = i32(p::GetIdIndex(oldId));
+		if (index >= remap.oldIds.Size())
+		{
+			remap.oldIds.Resize(index + 1, NoId);
+			remap.newIds.Resize(index + 1, NoId);
+		}
+		remap.oldIds[index] = oldId;
+		remap.newIds[index] = newId;
+	}
+
+	bool CompactTree(Tree& ast)
+	{
+		ZoneScoped;
+		if (!CanCompact(ast))
+		{
+			return false;
+		}
+
+		// Entities in hierarchy order, followed by entities outside of any hierarchy
+		TArray<Id> orderedIds;
+		orderedIds.Append(GetFlatHierarchy(ast).ids);
+		{
+			TArray<Id> otherIds;
+			for (const CompactedPool& pool : GetCompactedPools())
+			{
+				if (pool.getIds)
+				{
+					pool.getIds(ast, otherIds);
+				}
+			}
+			otherIds.Sort([](Id one, Id other) {
+				return one < other;
+			});
+			orderedIds.Append(otherIds);
+		}
+
+		Tree compacted;
+		IdRemap remap;
+
+		// Native types already exist in the new tree
+		const auto oldNativeIds = ast.GetNativeTypes().GetAll();
+		const auto newNativeIds = compacted.GetNativeTypes().GetAll();
+		for (i32 i = 0; i < NativeTypeIds::count; ++i)
+		{
+			if (!IsNone(oldNativeIds[i]))
+			{
+				AddToRemap(remap, oldNativeIds[i], newNativeIds[i]);
+			}
+		}
+
+		i32 entityCount = 0;
+		for (Id id : orderedIds)
+		{
+			if (IsNone(remap.Get(id)))
+			{
+				AddToRemap(remap, id, compacted.Create());
+				++entityCount;
+			}
+		}
+
+		for (const CompactedPool& pool : GetCompactedPools())
+		{
+			if (pool.copy)
+			{
+				pool.copy(ast, compacted, remap);
+			}
+		}
+
+		// Project trees keep running their systems
+		if (ast.HasStatic<SModules>())
+		{
+			InitProjectSystems(compacted);
+		}
+		// Moved after systems are initialized, since they reset some statics
+		for (const CompactedStatic& value : GetCompactedStatics())
+		{
+			value.move(ast, compacted, remap);
+		}
+
+		p::Info("Compacted tree: {} entities in {} id slots", entityCount, remap.oldIds.Size());
+		ast = Move(compacted);
+		return true;
+	}
+}    // namespace rift::AST
@@ -3,42 +3,90 @@
 #include "AST/Utils/Expressions.h"
 
 #include "AST/Id.h"
+#include "AST/Statics/SExprReachability.h"
+#include "AST/Utils/SystemScheduler.h"
 
 
 namespace rift::AST
 {
-	bool WouldExprLoop(
-	    TAccessRef<CExprInputs, CExprOutputs, CExprTypeId> access, Id outputNodeId, Id inputNodeId)
+	const TArray<Id>& FindOrCacheUpstreamNodes(TAccessRef<CExprInputs, CChild> access, Id nodeId)
 	{
-		TArray<Id> currentNodeIds{outputNodeId};
-		TArray<Id> nextNodeIds{};
-		while (!currentNodeIds.IsEmpty())
+		CheckStaticWrite<SExprReachability>();
+		auto& reachability = access.GetContext().GetOrSetStatic<SExprReachability>();
+		const Id graphId   = p::GetParent(access, nodeId);
+		auto* graph        = reachability.upstreamByGraph.Find(graphId);
+		if (!graph)
 		{
-			for (Id id : currentNodeIds)
+			if (reachability.upstreamByGraph.Size() >= SExprReachability::maxGraphs)
 			{
-				if (const auto* inputs = access.TryGet<const CExprInputs>(id))
+				reachability.upstreamByGraph = {};
+			}
+			reachability.upstreamByGraph.Insert(graphId, {});
+			graph = reachability.upstreamByGraph.Find(graphId);
+		}
+		else if (const TArray<Id>* upstream = graph->Find(nodeId))
+		{
+			return *upstream;
+		}
+
+		++reachability.visitGeneration;
+		if (reachability.visitGeneration == 0)    // Wrapped around, clear old marks
+		{
+			reachability.visitMarks.Clear(false);
+			reachability.visitGeneration = 1;
+		}
+		const u32 generation = reachability.visitGeneration;
+		auto& marks          = reachability.visitMarks;
+
+		TArray<Id> upstream;
+		TArray<Id> pendingIds{nodeId};
+		while (!pendingIds.IsEmpty())
+		{
+			const Id id = pendingIds.Last();
+			pendingIds.RemoveAt(pendingIds.Size() - 1, false);
+
+			const auto* inputs = access.TryGet<const CExprInputs>(id);
+			if (!inputs)
+			{
+				continue;
+			}
+			for (const ExprOutput& output : inputs->linkedOutputs)
+			{
+				if (IsNone(output.nodeId))
 				{
-					nextNodeIds.ReserveMore(inputs->linkedOutputs.Size());
-					for (ExprOutput output : inputs->linkedOutputs)
-					{
-						if (output.nodeId == inputNodeId)
-						{
-							return true;
-						}
-						else if (!IsNone(output.nodeId))
-						{
-							nextNodeIds.Add(output.nodeId);
-						}
-					}
+					continue;
+				}
+
+				const i32 index = i32(p::GetIdIndex(output.nodeId));
+				if (index >= marks.Size())
+				{
+					marks.Resize(index + 1, 0);
+				}
+				if (marks[index] != generation)    // Visit each node only once
+				{
+					marks[index] = generation;
+					upstream.Add(output.nodeId);
+					pendingIds.Add(output.nodeId);
 				}
 			}
-			currentNodeIds = nextNodeIds;
-			nextNodeIds.Clear(false);
 		}
-		return false;
+
+		upstream.Sort([](Id one, Id other) {
+			return one < other;
+		});
+		graph->Insert(nodeId, Move(upstream));
+		return *graph->Find(nodeId);
+	}
+
+	bool WouldExprLoop(TAccessRef<CExprInputs, CExprOutputs, CExprTypeId, CChild> access,
+	    Id outputNodeId, Id inputNodeId)
+	{
+		// Connecting would loop if the input node is already feeding the output node
+		const TArray<Id>& upstream = FindOrCacheUpstreamNodes(access, outputNodeId);
+		return upstream.FindSortedEqual(inputNodeId) != NO_INDEX;
 	}
 
-	bool CanConnectExpr(TAccessRef<CExprInputs, CExprOutputs, CExprTypeId> access,
+	bool CanConnectExpr(TAccessRef<CExprInputs, CExprOutputs, CExprTypeId, CChild> access,
 	    ExprOutput output, ExprInput input)
 	{
 		if (output.IsNone() || input.IsNone())
@@ -91,7 +139,7 @@ namespace rift::AST
 		return !WouldExprLoop(access, output.nodeId, input.nodeId);
 	}
 
-	bool TryConnectExpr(TAccessRef<TWrite<CExprInputs>, CExprOutputs, CExprTypeId> access,
+	bool TryConnectExpr(TAccessRef<TWrite<CExprInputs>, CExprOutputs, CExprTypeId, CChild> access,
 	    ExprOutput output, ExprInput input)
 	{
 		if (!CanConnectExpr(access, output, input))
@@ -108,6 +156,7 @@ namespace rift::AST
 		if (index != NO_INDEX && Ensure(index < inputs.linkedOutputs.Size()))
 		{
 			inputs.linkedOutputs[index] = output;
+			InvalidateExprReachability(access.GetContext(), input.nodeId);
 			return true;
 		}
 		return false;    // Pin was invalid
@@ -130,12 +179,40 @@ namespace rift::AST
 		{
 			ExprOutput& linked = inputs.linkedOutputs[index];
 			linked             = {};
+			InvalidateExprReachability(ast, input.nodeId);
 			return true;
 		}
 		return false;
 	}
 
 
+	void InvalidateExprReachability(p::EntityContext& ast, TView<const Id> nodeIds)
+	{
+		CheckStaticWrite<SExprReachability>();
+		auto* reachability = ast.TryGetStatic<SExprReachability>();
+		if (!reachability || reachability->upstreamByGraph.Size() <= 0)
+		{
+			return;
+		}
+
+		// Links only join nodes of the same graph, so only the graphs of edited nodes change
+		for (Id nodeId : nodeIds)
+		{
+			const Id graphId = ast.IsValid(nodeId) ? p::GetParent(ast, nodeId) : NoId;
+			if (IsNone(graphId))
+			{
+				// The graph is unknown (E.g: node was detached). Clear all
+				reachability->upstreamByGraph = {};
+				return;
+			}
+			if (reachability->upstreamByGraph.Find(graphId))
+			{
+				reachability->upstreamByGraph.Remove(graphId);
+			}
+		}
+	}
+
+
 	bool RemoveExprInputPin(TAccessRef<CExprInputs, TWrite<CInvalid>> access, ExprInput input)
 	{
 		if (!input.IsNone())
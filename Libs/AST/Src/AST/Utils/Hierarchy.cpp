@@ -0,0 +1,307 @@
+// Copyright 2015-2023 Piperift - All rights reserved
+
+#include "AST/Utils/Hierarchy.h"
+
+#include "AST/Tree.h"
+#include "AST/Utils/SystemScheduler.h"
+
+#include <Pipe/Core/Profiler.h>
+#include <Pipe/PipeECS.h>
+
+
+namespace rift::AST
+{
+	void AddToFlatHierarchy(Tree& ast, SHierarchy& hierarchy, Id id)
+	{
+		const i32 position = hierarchy.ids.Size();
+		hierarchy.ids.Add(id);
+		hierarchy.subtreeSizes.Add(1);
+
+		if (const auto* parent = ast.TryGet<const CParent>(id))
+		{
+			for (Id childId : parent->children)
+			{
+				AddToFlatHierarchy(ast, hierarchy, childId);
+			}
+		}
+		hierarchy.subtreeSizes[position] = hierarchy.ids.Size() - position;
+	}
+
+	// Updates the positions of all entities from a position to the end
+	void UpdatePositions(SHierarchy& hierarchy, i32 first)
+	{
+		for (i32 position = first; position < hierarchy.ids.Size(); ++position)
+		{
+			const i32 index = i32(p::GetIdIndex(hierarchy.ids[position]));
+			if (index >= hierarchy.positions.Size())
+			{
+				hierarchy.positions.Resize(index + 1, NO_INDEX);
+			}
+			hierarchy.positions[index] = position;
+		}
+	}
+
+	i32 FindPosition(const SHierarchy& hierarchy, Id id)
+	{
+		const i32 index = i32(p::GetIdIndex(id));
+		if (IsNone(id) || index >= hierarchy.positions.Size())
+		{
+			return NO_INDEX;
+		}
+		const i32 position = hierarchy.positions[index];
+		if (position == NO_INDEX || hierarchy.ids[position] != id)
+		{
+			return NO_INDEX;
+		}
+		return position;
+	}
+
+	void RebuildFlatHierarchy(Tree& ast, SHierarchy& hierarchy)
+	{
+		ZoneScoped;
+		hierarchy.ids.Clear(false);
+		hierarchy.subtreeSizes.Clear(false);
+		hierarchy.positions.Clear(false);
+
+		TArray<Id> rootIds = FindAllIdsWith<CParent>(ast);
+		ExcludeIdsWith<CChild>(ast, rootIds);
+		for (Id rootId : rootIds)
+		{
+			AddToFlatHierarchy(ast, hierarchy, rootId);
+		}
+		UpdatePositions(hierarchy, 0);
+		hierarchy.dirty = false;
+	}
+
+	// @return the flat hierarchy if it is up to date, without rebuilding it
+	SHierarchy* FindValidHierarchy(Tree& ast)
+	{
+		auto* hierarchy = ast.TryGetStatic<SHierarchy>();
+		return hierarchy && !hierarchy->dirty ? hierarchy : nullptr;
+	}
+
+	void AddAllChildren(Tree& ast, Id id, TArray<Id>& outChildrenIds)
+	{
+		if (const auto* parent = ast.TryGet<const CParent>(id))
+		{
+			for (Id childId : parent->children)
+			{
+				outChildrenIds.Add(childId);
+				AddAllChildren(ast, childId, outChildrenIds);
+			}
+		}
+	}
+
+	bool HasAncestorIn(Tree& ast, Id id, const TArray<Id>& sortedIds)
+	{
+		for (Id parentId = p::GetParent(ast, id); !IsNone(parentId);
+		     parentId    = p::GetParent(ast, parentId))
+		{
+			if (sortedIds.FindSortedEqual(parentId) != NO_INDEX)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+
+	const SHierarchy& GetFlatHierarchy(Tree& ast)
+	{
+		CheckStaticWrite<SHierarchy>();
+		auto& hierarchy = ast.GetOrSetStatic<SHierarchy>();
+		if (hierarchy.dirty)
+		{
+			RebuildFlatHierarchy(ast, hierarchy);
+		}
+		return hierarchy;
+	}
+
+	void InvalidateFlatHierarchy(Tree& ast)
+	{
+		CheckStaticWrite<SHierarchy>();
+		if (auto* hierarchy = ast.TryGetStatic<SHierarchy>())
+		{
+			hierarchy->dirty = true;
+		}
+	}
+
+	void GetAllChildren(Tree& ast, TView<const Id> ids, TArray<Id>& outChildrenIds)
+	{
+		CheckStaticRead<SHierarchy>();
+		const SHierarchy* hierarchy = FindValidHierarchy(ast);
+
+		TArray<Id> sortedIds;
+		sortedIds.Append(ids);
+		sortedIds.Sort([](Id one, Id other) {
+			return one < other;
+		});
+		TArray<Id> addedIds;
+		for (Id id : ids)
+		{
+			bool added = false;
+			addedIds.AddUniqueSorted(id, {}, &added);
+			// Subtrees inside other subtrees are added by them
+			if (!added || HasAncestorIn(ast, id, sortedIds))
+			{
+				continue;
+			}
+
+			if (!hierarchy)
+			{
+				AddAllChildren(ast, id, outChildrenIds);
+				continue;
+			}
+
+			// Entities not in the flat hierarchy have no children
+			const i32 position = FindPosition(*hierarchy, id);
+			if (position != NO_INDEX)
+			{
+				const i32 childCount = hierarchy->subtreeSizes[position] - 1;
+				outChildrenIds.Append(
+				    TView<const Id>{hierarchy->ids.Data() + position + 1, childCount});
+			}
+		}
+	}
+
+	void AttachChildren(Tree& ast, Id parentId, TView<Id> childIds)
+	{
+		if (childIds.Size() == 0)
+		{
+			return;
+		}
+
+		SHierarchy* hierarchy = FindValidHierarchy(ast);
+		// Only subtrees not in any hierarchy can be inserted
+		const bool newRoot = hierarchy && !ast.Has<CChild>(parentId)
+		                  && FindPosition(*hierarchy, parentId) == NO_INDEX;
+		for (i32 i = 0; hierarchy && i < childIds.Size(); ++i)
+		{
+			const Id childId = childIds[i];
+			if (ast.Has<CChild>(childId) || FindPosition(*hierarchy, childId) != NO_INDEX)
+			{
+				hierarchy = nullptr;
+			}
+		}
+
+		p::Attach(ast, parentId, childIds);
+		if (!hierarchy)
+		{
+			return;    // Hooks invalidated the flat hierarchy
+		}
+
+		CheckStaticWrite<SHierarchy>();
+		if (newRoot)
+		{
+			hierarchy->ids.Add(parentId);
+			hierarchy->subtreeSizes.Add(1);
+			UpdatePositions(*hierarchy, hierarchy->ids.Size() - 1);
+		}
+
+		SHierarchy added;
+		for (Id childId : childIds)
+		{
+			AddToFlatHierarchy(ast, added, childId);
+		}
+
+		const i32 parentPosition = FindPosition(*hierarchy, parentId);
+		const i32 insertPosition = parentPosition + hierarchy->subtreeSizes[parentPosition];
+		const i32 tailSize       = hierarchy->ids.Size() - insertPosition;
+
+		TArray<Id> ids;
+		ids.Reserve(hierarchy->ids.Size() + added.ids.Size());
+		ids.Append(TView<const Id>{hierarchy->ids.Data(), insertPosition});
+		ids.Append(added.ids);
+		ids.Append(TView<const Id>{hierarchy->ids.Data() + insertPosition, tailSize});
+		TArray<i32> subtreeSizes;
+		subtreeSizes.Reserve(ids.Size());
+		subtreeSizes.Append(TView<const i32>{hierarchy->subtreeSizes.Data(), insertPosition});
+		subtreeSizes.Append(added.subtreeSizes);
+		subtreeSizes.Append(
+		    TView<const i32>{hierarchy->subtreeSizes.Data() + insertPosition, tailSize});
+		hierarchy->ids          = Move(ids);
+		hierarchy->subtreeSizes = Move(subtreeSizes);
+
+		// Ancestors are placed before the inserted subtrees, so their positions didn't change
+		for (Id id = parentId; !IsNone(id); id = p::GetParent(ast, id))
+		{
+			hierarchy->subtreeSizes[FindPosition(*hierarchy, id)] += added.ids.Size();
+		}
+		UpdatePositions(*hierarchy, insertPosition);
+		hierarchy->dirty = false;
+	}
+
+	void RemoveWithChildren(HierarchyAccess access, TView<Id> ids)
+	{
+		auto& ast             = static_cast<Tree&>(access.GetContext());
+		SHierarchy* hierarchy = FindValidHierarchy(ast);
+		if (!hierarchy)
+		{
+			p::Remove(access, ids, true);
+			return;
+		}
+
+		CheckStaticWrite<SHierarchy>();
+		// Ancestors come first, so subtrees inside removed subtrees get skipped
+		TArray<i32> removedPositions;
+		for (Id id : ids)
+		{
+			const i32 position = FindPosition(*hierarchy, id);
+			if (position != NO_INDEX)
+			{
+				removedPositions.Add(position);
+			}
+		}
+		removedPositions.Sort([](i32 one, i32 other) {
+			return one < other;
+		});
+
+		// Mark the ranges of removed subtrees and shrink their ancestors before removing them
+		TArray<bool> removed;
+		removed.Resize(hierarchy->ids.Size(), false);
+		for (i32 position : removedPositions)
+		{
+			if (removed[position])
+			{
+				continue;
+			}
+			const i32 size = hierarchy->subtreeSizes[position];
+			for (Id parentId = p::GetParent(ast, hierarchy->ids[position]); !IsNone(parentId);
+			     parentId    = p::GetParent(ast, parentId))
+			{
+				hierarchy->subtreeSizes[FindPosition(*hierarchy, parentId)] -= size;
+			}
+			for (i32 i = position; i < position + size; ++i)
+			{
+				removed[i] = true;
+			}
+		}
+
+		p::Remove(access, ids, true);
+
+		i32 first = NO_INDEX;
+		i32 last  = 0;
+		for (i32 position = 0; position < hierarchy->ids.Size(); ++position)
+		{
+			if (removed[position])
+			{
+				if (first == NO_INDEX)
+				{
+					first = position;
+				}
+				hierarchy->positions[i32(p::GetIdIndex(hierarchy->ids[position]))] = NO_INDEX;
+				continue;
+			}
+			hierarchy->ids[last]          = hierarchy->ids[position];
+			hierarchy->subtreeSizes[last] = hierarchy->subtreeSizes[position];
+			++last;
+		}
+		hierarchy->ids.Resize(last);
+		hierarchy->subtreeSizes.Resize(last);
+		if (first != NO_INDEX)
+		{
+			UpdatePositions(*hierarchy, first);
+		}
+		hierarchy->dirty = false;
+	}
+}    // namespace rift::AST
@@ -0,0 +1,234 @@
+// Copyright 2015-2023 Piperift - All rights reserved
+
+#include "AST/Utils/MemoryStats.h"
+
+#include "AST/Statics/SExprReachability.h"
+#include "AST/Statics/SHierarchy.h"
+#include "AST/Statics/SLoadQueue.h"
+#include "AST/Statics/SModules.h"
+#include "AST/Statics/SNamespaceCache.h"
+#include "AST/Statics/SReferences.h"
+#include "AST/Statics/SStringLoad.h"
+#include "AST/Statics/STypes.h"
+#include "AST/Statics/SUndoHistory.h"
+#include "AST/Utils/Compaction.h"
+
+#include <Pipe/Core/Profiler.h>
+#include <Pipe/Core/Set.h>
+#include <Pipe/Reflect/TypeRegistry.h>
+#include <Pipe/Serialize/Formats/JsonFormat.h>
+
+
+namespace rift::AST
+{
+	// Only holds interned namespaces and tags
+	template<>
+	inline constexpr bool hasNoHeapBytes<CachedNamespace> = true;
+
+	template<typename T>
+	void AddStaticStats(Tree& ast, TreeMemoryStats& stats, p::StringView name,
+	    p::sizet (*getHeapBytes)(const T& value))
+	{
+		if (const T* value = ast.TryGetStatic<T>())
+		{
+			stats.statics.Add({p::String{name}, sizeof(T) + getHeapBytes(*value)});
+		}
+	}
+
+	void AddTag(p::TSet<p::Tag>& tags, p::Tag tag)
+	{
+		if (!tag.IsNone())
+		{
+			tags.Insert(tag);
+		}
+	}
+
+	void AddTagStats(Tree& ast, TreeMemoryStats& stats)
+	{
+		p::TSet<p::Tag> tags;
+		for (Id id : FindAllIdsWith<CNamespace>(ast))
+		{
+			AddTag(tags, ast.Get<const CNamespace>(id).name);
+		}
+		for (Id id : FindAllIdsWith<CDeclType>(ast))
+		{
+			AddTag(tags, ast.Get<const CDeclType>(id).typeId);
+		}
+		for (Id id : FindAllIdsWith<CExprDeclRef>(ast))
+		{
+			const auto& declRef = ast.Get<const CExprDeclRef>(id);
+			AddTag(tags, declRef.ownerName);
+			AddTag(tags, declRef.name);
+		}
+		for (Id id : FindAllIdsWith<CModule>(ast))
+		{
+			for (p::Tag dependency : ast.Get<const CModule>(id).dependencies)
+			{
+				AddTag(tags, dependency);
+			}
+		}
+		for (Id id : FindAllIdsWith<CExprCall>(ast))
+		{
+			for (p::Tag scope : ast.Get<const CExprCall>(id).function)
+			{
+				AddTag(tags, scope);
+			}
+		}
+		for (Id id : FindAllIdsWith<CExprType>(ast))
+		{
+			for (p::Tag scope : ast.Get<const CExprType>(id).type)
+			{
+				AddTag(tags, scope);
+			}
+		}
+
+		stats.tagCount = tags.Size();
+		for (const p::Tag& tag : tags)
+		{
+			stats.tagBytes += tag.AsString().size() + 1;
+		}
+	}
+
+	void Write(p::Writer& ct, const PoolMemoryStats& val)
+	{
+		ct.BeginObject();
+		ct.Next("name", val.name);
+		ct.Next("count", val.count);
+		ct.Next("inlineBytes", val.inlineBytes);
+		ct.Next("approximateHeapBytes", val.heapBytes);
+		ct.Next("registered", val.registered);
+	}
+
+	void Write(p::Writer& ct, const StaticMemoryStats& val)
+	{
+		ct.BeginObject();
+		ct.Next("name", val.name);
+		ct.Next("approximateBytes", val.bytes);
+	}
+
+
+	p::sizet TreeMemoryStats::GetPoolBytes() const
+	{
+		p::sizet bytes = 0;
+		for (const PoolMemoryStats& pool : pools)
+		{
+			bytes += pool.inlineBytes + pool.heapBytes;
+		}
+		return bytes;
+	}
+
+	p::sizet TreeMemoryStats::GetStaticBytes() const
+	{
+		p::sizet bytes = 0;
+		for (const StaticMemoryStats& value : statics)
+		{
+			bytes += value.bytes;
+		}
+		return bytes;
+	}
+
+	TreeMemoryStats GetMemoryStats(Tree& ast)
+	{
+		ZoneScoped;
+		TreeMemoryStats stats;
+
+		const auto& registry = p::TypeRegistry::Get();
+		for (const auto& poolInstance : ast.GetPools())
+		{
+			PoolMemoryStats& pool = stats.pools.AddRef({poolInstance.componentId});
+			auto* type            = registry.FindType(poolInstance.componentId);
+			if (type)
+			{
+				pool.name = type->GetName();
+			}
+
+			const CompactedPool* registered = nullptr;
+			for (const CompactedPool& compactedPool : GetCompactedPools())
+			{
+				if (compactedPool.typeId == poolInstance.componentId)
+				{
+					registered = &compactedPool;
+					break;
+				}
+			}
+			if (registered && registered->getMemoryStats)
+			{
+				registered->getMemoryStats(ast, pool);
+			}
+			else
+			{
+				// Components of unregistered pools can't be visited, only their size is known
+				pool.count = p::i32(poolInstance.GetPool()->Size());
+				if (type)
+				{
+					pool.inlineBytes = pool.count * type->GetSize();
+				}
+			}
+		}
+		stats.pools.Sort([](const PoolMemoryStats& one, const PoolMemoryStats& other) {
+			return one.inlineBytes + one.heapBytes > other.inlineBytes + other.heapBytes;
+		});
+
+		AddStaticStats<SModules>(ast, stats, "SModules", [](const SModules& value) {
+			return GetHeapBytes(value.modulesByPath);
+		});
+		AddStaticStats<STypes>(ast, stats, "STypes", [](const STypes& value) {
+			return GetHeapBytes(value.typesByName) + GetHeapBytes(value.typesByPath);
+		});
+		AddStaticStats<SNamespaceCache>(
+		    ast, stats, "SNamespaceCache", [](const SNamespaceCache& value) {
+			    return GetHeapBytes(value.entries);
+		    });
+		AddStaticStats<SReferences>(ast, stats, "SReferences", [](const SReferences& value) {
+			return GetHeapBytes(value.exprsByDecl) + GetHeapBytes(value.pendingCallExprs)
+			     + GetHeapBytes(value.pendingDeclRefExprs) + GetHeapBytes(value.pendingTypeExprs);
+		});
+		AddStaticStats<SExprReachability>(
+		    ast, stats, "SExprReachability", [](const SExprReachability& value) {
+			    return GetHeapBytes(value.upstreamByGraph) + GetHeapBytes(value.visitMarks);
+		    });
+		AddStaticStats<SHierarchy>(ast, stats, "SHierarchy", [](const SHierarchy& value) {
+			return GetHeapBytes(value.ids) + GetHeapBytes(value.subtreeSizes)
+			     + GetHeapBytes(value.positions);
+		});
+		AddStaticStats<SLoadQueue>(ast, stats, "SLoadQueue", [](const SLoadQueue& value) {
+			return GetHeapBytes(value.pendingSyncLoad) + GetHeapBytes(value.pendingAsyncLoad);
+		});
+		AddStaticStats<SStringLoad>(ast, stats, "SStringLoad", [](const SStringLoad& value) {
+			return GetHeapBytes(value.entities) + GetHeapBytes(value.paths)
+			     + GetHeapBytes(value.strings);
+		});
+		AddStaticStats<SUndoHistory>(ast, stats, "SUndoHistory", [](const SUndoHistory& value) {
+			// Component deltas are opaque. Only their pointers are counted
+			p::sizet bytes = value.transactions.Size() * sizeof(UndoTransaction);
+			for (const UndoTransaction& transaction : value.transactions)
+			{
+				bytes += GetHeapBytes(transaction.ids) + GetHeapBytes(transaction.destroyedIds)
+				       + GetHeapBytes(transaction.createdIds)
+				       + transaction.deltas.Size() * sizeof(void*);
+			}
+			return bytes;
+		});
+
+		stats.namespaceCount = Namespace::GetTableSize();
+		stats.namespaceBytes = Namespace::GetTableBytes();
+		AddTagStats(ast, stats);
+		return stats;
+	}
+
+	p::String MemoryStatsToJson(const TreeMemoryStats& stats)
+	{
+		JsonFormatWriter writer{};
+		p::Writer& w = writer.GetWriter();
+		w.BeginObject();
+		w.Next("pools", stats.pools);
+		w.Next("statics", stats.statics);
+		w.Next("namespaceCount", stats.namespaceCount);
+		w.Next("namespaceBytes", stats.namespaceBytes);
+		w.Next("tagCount", stats.tagCount);
+		w.Next("approximateTagBytes", stats.tagBytes);
+		w.Next("approximatePoolBytes", stats.GetPoolBytes());
+		w.Next("approximateStaticBytes", stats.GetStaticBytes());
+		return writer.ToString();
+	}
+}    // namespace rift::AST
@@ -78,9 +78,7 @@ namespace rift::AST
 		ast = Tree{};
 		ast.SetStatic<SModules>();
 		ast.SetStatic<STypes>();
-		LoadSystem::Init(ast);
-		TypeSystem::Init(ast);
-		FunctionsSystem::Init(ast);
+		InitProjectSystems(ast);
 
 		// Create project node (root module)
 		Id projectId = ast.Create();
@@ -100,6 +98,13 @@ namespace rift::AST
 		ast.Reset();
 	}
 
+	void InitProjectSystems(Tree& ast)
+	{
+		LoadSystem::Init(ast);
+		TypeSystem::Init(ast);
+		FunctionsSystem::Init(ast);
+	}
+
 	Id CreateModule(Tree& ast, p::StringView path)
 	{
 		String validatedPath{path};
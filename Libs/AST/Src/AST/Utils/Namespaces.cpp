@@ -4,6 +4,9 @@
 
 #include "AST/Components/CNamespace.h"
 #include "AST/Id.h"
+#include "AST/Statics/SNamespaceCache.h"
+#include "AST/Tree.h"
+#include "AST/Utils/SystemScheduler.h"
 #include "Pipe/Core/StringView.h"
 
 #include <Pipe/Math/Math.h>
@@ -12,33 +15,42 @@
 
 namespace rift::AST
 {
-	Namespace GetNamespace(TAccessRef<CNamespace, CChild, CModule> access, Id id)
+	const SNamespaceCache* FindNamespaceCache(NamespaceAccess access)
 	{
-		Namespace ns;
-		TArray<Id> idChain;
-		idChain.Reserve(Namespace::scopeCount);
+		CheckStaticRead<SNamespaceCache>();
+		return static_cast<Tree&>(access.GetContext()).TryGetStatic<SNamespaceCache>();
+	}
 
-		while (!IsNone(id))
+	// Resolves the namespace of an entity from the closest cached parent. Never writes the cache
+	Namespace FindNamespace(NamespaceAccess access, const SNamespaceCache* cache, Id id)
+	{
+		if (cache)
 		{
-			idChain.Add(id);
-			if (access.Has<CModule>(id))
+			if (const CachedNamespace* cached = cache->entries.Find(id))
 			{
-				break;
+				return cached->ns;
 			}
-			id = p::GetParent(access, id);
 		}
 
-		i32 i, scopeIndex = 0;
-		for (i = idChain.Size() - 1; i >= 0 && scopeIndex < Namespace::scopeCount; --i)
+		Namespace ns;
+		const Id parentId = access.Has<CModule>(id) ? NoId : p::GetParent(access, id);
+		if (!IsNone(parentId))
 		{
-			ns.scopes[scopeIndex] = GetName(access, idChain[i]);
-			++scopeIndex;
+			ns = FindNamespace(access, cache, parentId);
 		}
-		CheckMsg(i < 0, "Not enough scopes to cover this namespace");
-		return ns;
+		return Namespace{ns, GetName(access, id)};
 	}
 
-	Namespace GetParentNamespace(TAccessRef<CNamespace, CChild, CModule> access, Id id)
+	Namespace GetNamespace(NamespaceAccess access, Id id)
+	{
+		if (!access.IsValid(id))
+		{
+			return {};
+		}
+		return FindNamespace(access, FindNamespaceCache(access), id);
+	}
+
+	Namespace GetParentNamespace(NamespaceAccess access, Id id)
 	{
 		if (!IsNone(id))
 		{
@@ -61,15 +73,11 @@ namespace rift::AST
 		const TArray<Id>* scopeIds = rootIds;
 		Id foundScopeId            = NoId;
 		Tag scopeName;
-		i32 depth = 0;
-		while (scopeIds && depth < Namespace::scopeCount)
+		i32 depth      = 0;
+		const i32 size = ns.Size();
+		while (scopeIds && depth < size)
 		{
 			scopeName = ns[depth];
-			if (scopeName.IsNone())
-			{
-				break;
-			}
-
 			foundScopeId = NoId;
 			for (Id id : *scopeIds)
 			{
@@ -105,10 +113,114 @@ namespace rift::AST
 		return access.Get<const CNamespace>(id).name;
 	}
 
-	p::String GetFullName(
-	    TAccessRef<CNamespace, CChild, CModule> access, Id id, bool localNamespace)
+	Tag GetFullName(NamespaceAccess access, Id id, bool localNamespace)
 	{
-		return GetNamespace(access, id).ToString(localNamespace);
+		if (!access.IsValid(id))
+		{
+			return {};
+		}
+
+		const SNamespaceCache* cache = FindNamespaceCache(access);
+		if (const CachedNamespace* cached = cache ? cache->entries.Find(id) : nullptr)
+		{
+			return localNamespace ? cached->localFullName : cached->fullName;
+		}
+		// Unnamed entities and entities changed since they were cached are resolved every time
+		return Tag{FindNamespace(access, cache, id).ToString(localNamespace)};
 	}
 
+	void CacheNamespaces(NamespaceCacheAccess access, TView<const Id> ids)
+	{
+		CheckStaticWrite<SNamespaceCache>();
+		auto* cache = static_cast<Tree&>(access.GetContext()).TryGetStatic<SNamespaceCache>();
+		if (!cache)
+		{
+			return;
+		}
+
+		// Parents are cached before their children, so each namespace is resolved only once
+		TArray<Id> currentIds;
+		currentIds.Append(ids);
+		TArray<Id> childrenIds;
+		while (!currentIds.IsEmpty())
+		{
+			for (Id id : currentIds)
+			{
+				if (!access.Has<CNamespace>(id))
+				{
+					cache->entries.Remove(id);
+					continue;
+				}
+
+				const Namespace ns = FindNamespace(access, cache, id);
+				CachedNamespace entry{ns, Tag{ns.ToString()}, Tag{ns.ToString(true)}};
+				if (CachedNamespace* cached = cache->entries.Find(id))
+				{
+					*cached = Move(entry);
+				}
+				else
+				{
+					cache->entries.Insert(id, Move(entry));
+				}
+			}
+
+			// Modules don't depend on their parents
+			childrenIds.Clear(false);
+			p::GetChildren(access, currentIds, childrenIds);
+			ExcludeIdsWith<CModule>(access, childrenIds);
+			currentIds.Clear(false);
+			currentIds.Append(childrenIds);
+		}
+	}
+
+	void CacheAllNamespaces(NamespaceCacheAccess access)
+	{
+		TArray<Id> rootIds = FindAllIdsWith<CNamespace>(access);
+		ExcludeIdsWith<CChild>(access, rootIds);
+		rootIds.Append(FindAllIdsWith<CModule>(access));
+		CacheNamespaces(access, rootIds);
+	}
+
+	void InvalidateNamespaceCache(TAccessRef<CParent, CModule> access, TView<const Id> ids)
+	{
+		CheckStaticWrite<SNamespaceCache>();
+		auto* cache = static_cast<Tree&>(access.GetContext()).TryGetStatic<SNamespaceCache>();
+		if (!cache)
+		{
+			return;
+		}
+
+		if (cache->entries.Size() <= 0)
+		{
+			return;
+		}
+
+		TArray<Id> currentIds;
+		for (Id id : ids)
+		{
+			if (cache->entries.Find(id))
+			{
+				cache->entries.Remove(id);
+				currentIds.Add(id);
+			}
+		}
+
+		TArray<Id> childrenIds;
+		while (!currentIds.IsEmpty())
+		{
+			// Uncached entities can't have cached children. Modules don't depend on their parents
+			childrenIds.Clear(false);
+			p::GetChildren(access, currentIds, childrenIds);
+			ExcludeIdsWith<CModule>(access, childrenIds);
+			currentIds.Clear(false);
+			for (Id childId : childrenIds)
+			{
+				if (cache->entries.Find(childId))
+				{
+					cache->entries.Remove(childId);
+					currentIds.Add(childId);
+				}
+			}
+		}
+	}
 }    // namespace rift::AST
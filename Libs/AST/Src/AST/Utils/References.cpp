@@ -0,0 +1,163 @@
+// Copyright 2015-2023 Piperift - All rights reserved
+
+#include "AST/Utils/References.h"
+
+#include "AST/Components/CExprCall.h"
+#include "AST/Components/CExprDeclRef.h"
+#include "AST/Components/CExprType.h"
+#include "AST/Statics/SReferences.h"
+#include "AST/Tree.h"
+#include "AST/Utils/SystemScheduler.h"
+
+#include <Pipe/Core/Profiler.h>
+#include <Pipe/PipeECS.h>
+
+
+namespace rift::AST
+{
+	using ReferenceAccess = TAccessRef<CExprCallId, CExprDeclRefId, CExprTypeId>;
+
+
+	bool IsReferencing(ReferenceAccess access, Id exprId, Id declId)
+	{
+		if (!access.IsValid(exprId))
+		{
+			return false;
+		}
+		const auto* call = access.TryGet<const CExprCallId>(exprId);
+		if (call && call->functionId == declId)
+		{
+			return true;
+		}
+		const auto* declRef = access.TryGet<const CExprDeclRefId>(exprId);
+		if (declRef && declRef->declarationId == declId)
+		{
+			return true;
+		}
+		const auto* type = access.TryGet<const CExprTypeId>(exprId);
+		return type && type->id == declId;
+	}
+
+	void IndexReference(SReferences& references, Id declId, Id exprId)
+	{
+		if (IsNone(declId))
+		{
+			return;
+		}
+
+		TArray<Id>* exprIds = references.exprsByDecl.Find(declId);
+		if (!exprIds)
+		{
+			references.exprsByDecl.Insert(declId, {});
+			exprIds = references.exprsByDecl.Find(declId);
+		}
+		exprIds->AddUniqueSorted(exprId);
+	}
+
+	SReferences& UpdateReferences(Tree& ast)
+	{
+		CheckStaticWrite<SReferences>();
+		SReferences* references = ast.TryGetStatic<SReferences>();
+		if (!references)
+		{
+			// First query on this tree. Index all existing references
+			references = &ast.GetOrSetStatic<SReferences>();
+			references->pendingCallExprs    = FindAllIdsWith<CExprCallId>(ast);
+			references->pendingDeclRefExprs = FindAllIdsWith<CExprDeclRefId>(ast);
+			references->pendingTypeExprs    = FindAllIdsWith<CExprTypeId>(ast);
+		}
+
+		ZoneScopedN("Index pending references");
+		ReferenceAccess access{ast};
+		for (Id exprId : references->pendingCallExprs)
+		{
+			if (const auto* call = access.TryGet<const CExprCallId>(exprId))
+			{
+				IndexReference(*references, call->functionId, exprId);
+			}
+		}
+		for (Id exprId : references->pendingDeclRefExprs)
+		{
+			if (const auto* declRef = access.TryGet<const CExprDeclRefId>(exprId))
+			{
+				IndexReference(*references, declRef->declarationId, exprId);
+			}
+		}
+		for (Id exprId : references->pendingTypeExprs)
+		{
+			if (const auto* type = access.TryGet<const CExprTypeId>(exprId))
+			{
+				IndexReference(*references, type->id, exprId);
+			}
+		}
+		references->pendingCallExprs.Clear(false);
+		references->pendingDeclRefExprs.Clear(false);
+		references->pendingTypeExprs.Clear(false);
+		return *references;
+	}
+
+	void FindReferences(Tree& ast, Id declId, TArray<Id>& outExprIds)
+	{
+		FindReferences(ast, TView<const Id>{&declId, 1}, outExprIds);
+	}
+
+	void FindReferences(Tree& ast, TView<const Id> declIds, TArray<Id>& outExprIds)
+	{
+		SReferences& references = UpdateReferences(ast);
+		ReferenceAccess access{ast};
+		for (Id declId : declIds)
+		{
+			TArray<Id>* exprIds = references.exprsByDecl.Find(declId);
+			if (!exprIds)
+			{
+				continue;
+			}
+
+			for (i32 i = 0; i < exprIds->Size();)
+			{
+				const Id exprId = (*exprIds)[i];
+				if (IsReferencing(access, exprId, declId))
+				{
+					outExprIds.Add(exprId);
+					++i;
+				}
+				else    // Removed or pointing somewhere else now
+				{
+					exprIds->RemoveAt(i, false);
+				}
+			}
+
+			if (exprIds->IsEmpty())
+			{
+				references.exprsByDecl.Remove(declId);
+			}
+		}
+	}
+
+	TArray<Id>& GetPendingExprs(SReferences& references, CExprCallId*)
+	{
+		return references.pendingCallExprs;
+	}
+	TArray<Id>& GetPendingExprs(SReferences& references, CExprDeclRefId*)
+	{
+		return references.pendingDeclRefExprs;
+	}
+	TArray<Id>& GetPendingExprs(SReferences& references, CExprTypeId*)
+	{
+		return references.pendingTypeExprs;
+	}
+
+	template<typename T>
+	void MarkReferencesChanged(Tree& ast, TView<const Id> exprIds)
+	{
+		CheckStaticWrite<SReferences>();
+		// If there is no index yet, it will be fully built when first queried
+		if (auto* references = ast.TryGetStatic<SReferences>())
+		{
+			GetPendingExprs(*references, static_cast<T*>(nullptr)).Append(exprIds);
+		}
+	}
+	template void MarkReferencesChanged<CExprCallId>(Tree&, TView<const Id>);
+	template void MarkReferencesChanged<CExprDeclRefId>(Tree&, TView<const Id>);
+	template void MarkReferencesChanged<CExprTypeId>(Tree&, TView<const Id>);
+}    // namespace rift::AST
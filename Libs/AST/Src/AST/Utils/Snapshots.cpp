@@ -0,0 +1,67 @@
+// Copyright 2015-2023 Piperift - All rights reserved
+
+#include "AST/Utils/Snapshots.h"
+
+#include "AST/Components/CFileRef.h"
+#include "AST/Statics/SSnapshot.h"
+#include "AST/Utils/PoolVersions.h"
+#include "AST/Utils/SystemScheduler.h"
+
+#include <Pipe/Core/Profiler.h>
+#include <Pipe/PipeECS.h>
+
+#include <algorithm>
+
+
+namespace rift::AST
+{
+	TreeSnapshot TakeSnapshot(Tree& ast)
+	{
+		ZoneScoped;
+		auto& snapshot    = ast.GetOrSetStatic<SSnapshot>();
+		const u64 version = GetEditVersion(ast);
+		if (!snapshot.tree || snapshot.version != version)
+		{
+			TOwnPtr<Tree> tree = MakeOwned<Tree>(ast);
+			// Never keep older snapshots alive from a new one
+			if (auto* copiedSnapshot = tree->TryGetStatic<SSnapshot>())
+			{
+				copiedSnapshot->tree = {};
+			}
+			snapshot.tree    = Move(tree);
+			snapshot.version = version;
+		}
+		return snapshot.tree;
+	}
+
+	TreeSnapshot FindSnapshot(Tree& ast)
+	{
+		const auto* snapshot = ast.TryGetStatic<SSnapshot>();
+		if (snapshot && snapshot->version == GetEditVersion(ast))
+		{
+			return snapshot->tree;
+		}
+		return {};
+	}
+
+	void MarkEdited(Tree& ast)
+	{
+		CheckStaticWrite<SPoolVersions>();
+		ast.GetOrSetStatic<SPoolVersions>().editVersion = NewPoolVersion();
+	}
+
+	bool IsSnapshotOutdated(Tree& ast, const TreeSnapshot& snapshot)
+	{
+		// Only the last snapshot is kept. Older ones are released when replaced
+		return !snapshot || !FindSnapshot(ast);
+	}
+
+	u64 GetEditVersion(Tree& ast)
+	{
+		CheckStaticRead<SPoolVersions>();
+		const u64 editVersion = ast.GetOrSetStatic<SPoolVersions>().editVersion;
+		// Created and removed nodes are attached or detached from their parents
+		return std::max(
+		    {editVersion, GetPoolVersion<CFileRef>(ast), GetPoolVersion<CChild>(ast)});
+	}
+}    // namespace rift::AST
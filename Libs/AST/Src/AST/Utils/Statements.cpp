@@ -192,7 +192,7 @@ namespace rift::AST
 		}
 	}
 
-	TView<Id> GetNextStmts(TAccessRef<CStmtOutputs> access, Id stmtIds)
+	TView<const Id> GetNextStmts(TAccessRef<CStmtOutputs> access, Id stmtIds)
 	{
 		if (const auto* output = access.TryGet<const CStmtOutputs>(stmtIds))
 		{
@@ -0,0 +1,197 @@
+// Copyright 2015-2023 Piperift - All rights reserved
+
+#include "AST/Utils/SystemScheduler.h"
+
+#include <Pipe/Core/Checks.h>
+#include <Pipe/Core/Profiler.h>
+#include <taskflow/taskflow.hpp>
+
+#include <chrono>
+#include <mutex>
+
+
+namespace rift::AST
+{
+	tf::Executor& GetSystemExecutor()
+	{
+		static tf::Executor executor;
+		return executor;
+	}
+
+
+	struct HookWritesRegistry
+	{
+		std::mutex mutex;
+		p::TMap<p::TypeId, p::TArray<p::TypeId>> writesByType;
+	};
+
+	HookWritesRegistry& GetHookWritesRegistry()
+	{
+		static HookWritesRegistry registry;
+		return registry;
+	}
+
+	// System running on this thread, with its hook writes. Used to check the statics it accesses
+	thread_local const SystemScheduler::System* gRunningSystem = nullptr;
+	thread_local const SystemAccess* gRunningAccess            = nullptr;
+
+
+	void AddHookWrites(SystemAccess& access)
+	{
+		auto& registry = GetHookWritesRegistry();
+		std::scoped_lock lock{registry.mutex};
+		// Hooks can write components with hooks of their own. Written types are appended
+		for (i32 i = 0; i < access.writes.Size(); ++i)
+		{
+			if (const auto* writes = registry.writesByType.Find(access.writes[i]))
+			{
+				for (p::TypeId type : *writes)
+				{
+					if (!access.writes.Contains(type))
+					{
+						access.writes.Add(type);
+					}
+				}
+			}
+		}
+	}
+
+	// Runs a system and saves its time. Each system only writes its own time
+	void RunSystem(
+	    const SystemScheduler::System& system, const SystemAccess& access, Tree& ast, float& time)
+	{
+		gRunningSystem   = &system;
+		gRunningAccess   = &access;
+		const auto start = std::chrono::steady_clock::now();
+		system.run(ast);
+		time = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start)
+		           .count();
+		gRunningSystem = nullptr;
+		gRunningAccess = nullptr;
+	}
+
+
+	void RegisterHookWrites(p::TypeId type, p::TView<const p::TypeId> writes)
+	{
+		auto& registry = GetHookWritesRegistry();
+		std::scoped_lock lock{registry.mutex};
+		p::TArray<p::TypeId>* typeWrites = registry.writesByType.Find(type);
+		if (!typeWrites)
+		{
+			registry.writesByType.Insert(type, {});
+			typeWrites = registry.writesByType.Find(type);
+		}
+		// Hooks are bound once per tree, so the same writes get registered many times
+		for (p::TypeId write : writes)
+		{
+			if (!typeWrites->Contains(write))
+			{
+				typeWrites->Add(write);
+			}
+		}
+	}
+
+
+#if P_DEBUG
+	void CheckStaticAccess(p::TypeId type, bool write)
+	{
+		const SystemAccess* access = gRunningAccess;
+		if (!access || access->exclusive)
+		{
+			return;
+		}
+		const bool declared =
+		    access->writes.Contains(type) || (!write && access->reads.Contains(type));
+		CheckMsg(declared,
+		    "System '{}' {} a static it doesn't declare. Declare it on the system or register it "
+		    "as a hook write of the component that changes it",
+		    gRunningSystem->name, write ? "writes" : "reads");
+	}
+#endif
+
+
+	bool SystemAccess::Conflicts(const SystemAccess& other) const
+	{
+		if (exclusive || other.exclusive)
+		{
+			return true;
+		}
+
+		for (p::TypeId type : writes)
+		{
+			if (other.writes.Contains(type) || other.reads.Contains(type))
+			{
+				return true;
+			}
+		}
+		for (p::TypeId type : other.writes)
+		{
+			if (reads.Contains(type))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+
+	void SystemScheduler::Run(Tree& ast)
+	{
+		ZoneScoped;
+		times.Resize(systems.Size(), 0.f);
+		if (systems.IsEmpty())
+		{
+			return;
+		}
+
+		// Hooks may have been bound after the systems were added
+		p::TArray<SystemAccess> accesses;
+		accesses.Reserve(systems.Size());
+		for (const System& system : systems)
+		{
+			AddHookWrites(accesses.AddRef(system.access));
+		}
+
+		if (systems.Size() == 1)
+		{
+			RunSystem(systems[0], accesses[0], ast, times[0]);
+			return;
+		}
+
+		// Pools can't be created while systems run in parallel
+		for (const System& system : systems)
+		{
+			if (system.assurePools)
+			{
+				system.assurePools(ast);
+			}
+		}
+
+		tf::Taskflow taskflow;
+		p::TArray<tf::Task> tasks;
+		tasks.Reserve(systems.Size());
+		for (i32 i = 0; i < systems.Size(); ++i)
+		{
+			const System& system       = systems[i];
+			const SystemAccess& access = accesses[i];
+			float& time                = times[i];
+			tf::Task task              = taskflow.emplace([&system, &access, &ast, &time]() {
+				ZoneScopedN("System");
+				ZoneName(system.name.data(), system.name.size());
+				RunSystem(system, access, ast, time);
+			});
+			task.name(std::string{system.name});
+
+			// Keep the order of addition between conflicting systems
+			for (i32 j = 0; j < i; ++j)
+			{
+				if (accesses[i].Conflicts(accesses[j]))
+				{
+					tasks[j].precede(task);
+				}
+			}
+			tasks.Add(task);
+		}
+		GetSystemExecutor().run(taskflow).wait();
+	}
+}    // namespace rift::AST
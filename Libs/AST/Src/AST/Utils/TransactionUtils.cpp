@@ -2,8 +2,22 @@
 
 #include "AST/Utils/TransactionUtils.h"
 
-#include "AST/Components/CDeclType.h"
+#include "AST/Components/CDeclVariable.h"
+#include "AST/Components/CExprCall.h"
+#include "AST/Components/CExprDeclRef.h"
+#include "AST/Components/CExprInputs.h"
+#include "AST/Components/CExprType.h"
+#include "AST/Statics/SNamespaceCache.h"
+#include "AST/Systems/TypeSystem.h"
+#include "AST/Tree.h"
+#include "AST/Utils/Compaction.h"
+#include "AST/Utils/Expressions.h"
+#include "AST/Utils/Hierarchy.h"
+#include "AST/Utils/Namespaces.h"
+#include "AST/Utils/References.h"
+#include "AST/Utils/Snapshots.h"
 
+#include <Pipe/Core/Profiler.h>
 #include <Pipe/PipeECS.h>
 
 
@@ -12,6 +26,240 @@ namespace rift::AST::Transactions
 	// Transaction being recorded
 	static Transaction gActiveTransaction = {};
 
+
+	void RemapId(const TMap<Id, Id>& remap, Id& id)
+	{
+		if (const Id* newId = remap.Find(id))
+		{
+			id = *newId;
+		}
+	}
+
+	ComponentDeltas* FindDeltas(UndoTransaction& transaction, p::TypeId typeId)
+	{
+		for (auto& deltas : transaction.deltas)
+		{
+			if (deltas->typeId == typeId)
+			{
+				return deltas.get();
+			}
+		}
+		return nullptr;
+	}
+
+	// Captures components of registered pools on the touched entities before the change
+	void CaptureTrackedDeltas(Tree& ast, UndoTransaction& transaction)
+	{
+		for (const CompactedPool& pool : GetCompactedPools())
+		{
+			if (pool.captureDeltas)
+			{
+				if (auto deltas = pool.captureDeltas(ast, transaction.ids, true))
+				{
+					transaction.deltas.Add(Move(deltas));
+				}
+			}
+		}
+	}
+
+	// Captures components added by the change to entities that had none of them before
+	void CaptureAddedDeltas(Tree& ast, UndoTransaction& transaction)
+	{
+		TArray<Id> ids;
+		ids.Reserve(transaction.ids.Size() + transaction.createdIds.Size());
+		ids.Append(transaction.ids);
+		ids.Append(transaction.createdIds);
+		for (const CompactedPool& pool : GetCompactedPools())
+		{
+			if (pool.captureDeltas && !FindDeltas(transaction, pool.typeId))
+			{
+				if (auto deltas = pool.captureDeltas(ast, ids, false))
+				{
+					transaction.deltas.Add(Move(deltas));
+				}
+			}
+		}
+	}
+
+	void MarkChanged(const TransactionAccess& access, TView<const Id> entityIds)
+	{
+		// Mark files dirty
+		TArray<Id> parentIds;
+		p::GetAllParents(access, entityIds, parentIds);
+
+		parentIds.Append(entityIds);
+		access.AddN<CChanged>(parentIds);
+
+		// Changed entities may get renamed
+		InvalidateNamespaceCache(static_cast<Tree&>(access.GetContext()), entityIds);
+
+		// Transaction ids can also be files. FindParents doesn't consider them, so we merge it
+		ExcludeIdsWithout<CFileRef>(access, parentIds);
+		if (!parentIds.IsEmpty())
+		{
+			access.AddN<CFileDirty>(parentIds);
+		}
+	}
+
+	// Updates caches and dirty state of entities after restoring their components
+	void MarkRestored(Tree& ast, TView<const Id> ids)
+	{
+		TArray<Id> validIds;
+		validIds.Reserve(ids.Size());
+		for (Id id : ids)
+		{
+			if (ast.IsValid(id))
+			{
+				validIds.Add(id);
+			}
+		}
+		MarkChanged(ast, validIds);
+		CacheNamespaces(ast, validIds);
+		MarkEdited(ast);
+
+		InvalidateExprReachability(ast, validIds);
+		MarkReferencesChanged<CExprCallId>(ast, FindIdsWith<CExprCallId>(ast, validIds));
+		MarkReferencesChanged<CExprDeclRefId>(ast, FindIdsWith<CExprDeclRefId>(ast, validIds));
+		MarkReferencesChanged<CExprTypeId>(ast, FindIdsWith<CExprTypeId>(ast, validIds));
+		ast.AddN<CPinsDirty>(FindIdsWith<CExprInputs>(ast, validIds));
+		ast.AddN<CDeclRefDirty>(FindIdsWith<CExprDeclRefId>(ast, validIds));
+		// References keep the type of restored variables
+		for (Id variableId : FindIdsWith<CDeclVariable>(ast, validIds))
+		{
+			TypeSystem::MarkVariableRefsDirty(ast, variableId);
+		}
+	}
+
+	void RecordUndo(Tree& ast, UndoTransaction&& transaction, const TArray<Id>& previousChildIds)
+	{
+		ZoneScoped;
+		// Children that appeared on touched entities were created by the transaction
+		TArray<Id> childIds;
+		for (Id id : transaction.ids)
+		{
+			if (ast.IsValid(id))
+			{
+				p::GetChildren(ast, id, childIds);
+			}
+		}
+		for (Id childId : childIds)
+		{
+			if (!previousChildIds.Contains(childId) && !transaction.ids.Contains(childId))
+			{
+				transaction.createdIds.Add(childId);
+			}
+		}
+		if (!transaction.createdIds.IsEmpty())
+		{
+			childIds.Clear(false);
+			GetAllChildren(ast, transaction.createdIds, childIds);
+			transaction.createdIds.Append(childIds);
+			for (auto& deltas : transaction.deltas)
+			{
+				deltas->AddCreated(transaction.createdIds);
+			}
+		}
+		CaptureAddedDeltas(ast, transaction);
+
+		for (i32 i = transaction.deltas.Size() - 1; i >= 0; --i)
+		{
+			if (!transaction.deltas[i]->CaptureAfter(ast))
+			{
+				transaction.deltas.RemoveAtSwapUnsafe(i);
+			}
+		}
+		for (Id id : transaction.ids)
+		{
+			if (!ast.IsValid(id))
+			{
+				transaction.destroyedIds.Add(id);
+			}
+		}
+		if (transaction.deltas.IsEmpty() && transaction.destroyedIds.IsEmpty()
+		    && transaction.createdIds.IsEmpty())
+		{
+			return;
+		}
+
+		auto& history = ast.GetOrSetStatic<SUndoHistory>();
+		// Recording discards transactions that could be redone
+		history.count = history.undoable;
+		if (history.count < SUndoHistory::capacity)
+		{
+			const i32 index = (history.first + history.count) % SUndoHistory::capacity;
+			if (index < history.transactions.Size())
+			{
+				history.transactions[index] = Move(transaction);
+			}
+			else
+			{
+				history.transactions.Add(Move(transaction));
+			}
+			++history.count;
+		}
+		else    // Full. Replace the oldest transaction
+		{
+			history.transactions[history.first] = Move(transaction);
+			history.first = (history.first + 1) % SUndoHistory::capacity;
+		}
+		history.undoable = history.count;
+	}
+
+	void RemapIds(UndoTransaction& transaction, const TMap<Id, Id>& remap)
+	{
+		for (Id& id : transaction.ids)
+		{
+			RemapId(remap, id);
+		}
+		for (Id& id : transaction.destroyedIds)
+		{
+			RemapId(remap, id);
+		}
+		for (Id& id : transaction.createdIds)
+		{
+			RemapId(remap, id);
+		}
+		for (auto& deltas : transaction.deltas)
+		{
+			deltas->RemapIds(remap);
+		}
+	}
+
+	/**
+	 * Creates new entities for the ones that don't exist anymore. Ids can't be reused, so the
+	 * whole history is remapped to the new ones. History is bounded, and so is the cost.
+	 */
+	void Recreate(Tree& ast, SUndoHistory& history, TView<const Id> ids)
+	{
+		TMap<Id, Id> remap;
+		for (Id id : ids)
+		{
+			if (!ast.IsValid(id))
+			{
+				remap.Insert(id, ast.Create());
+			}
+		}
+		if (remap.Size() > 0)
+		{
+			for (UndoTransaction& transaction : history.transactions)
+			{
+				RemapIds(transaction, remap);
+			}
+		}
+	}
+
+	void Destroy(Tree& ast, TView<const Id> ids)
+	{
+		for (Id id : ids)
+		{
+			if (ast.IsValid(id))
+			{
+				ast.Destroy(id);
+			}
+		}
+	}
+
+
 	ScopedTransaction::ScopedTransaction(const TransactionAccess& access, TView<const Id> entityIds)
 	{
 		active = PreChange(access, entityIds);
@@ -29,6 +277,26 @@ namespace rift::AST::Transactions
 		}
 	}
 
+	// Changed entities were uncached when the transaction started, since they may get renamed
+	void RecacheChangedNamespaces(Tree& ast, TView<const Id> ids)
+	{
+		const auto* cache = ast.TryGetStatic<SNamespaceCache>();
+		if (!cache)
+		{
+			return;
+		}
+
+		TArray<Id> changedIds;
+		for (Id id : ids)
+		{
+			if (ast.IsValid(id) && !cache->entries.Find(id))
+			{
+				changedIds.Add(id);
+			}
+		}
+		CacheNamespaces(ast, changedIds);
+	}
+
 	bool PreChange(const TransactionAccess& access, TView<const Id> entityIds)
 	{
 		if (!EnsureMsg(!gActiveTransaction.active,
@@ -39,21 +307,29 @@ namespace rift::AST::Transactions
 
 		gActiveTransaction = Transaction{true};
 
-		// Mark files dirty
-		TArray<Id> parentIds;
-		p::GetAllParents(access, entityIds, parentIds);
-
-		parentIds.Append(entityIds);
-		access.AddN<CChanged>(parentIds);
+		MarkChanged(access, entityIds);
 
-		// Transaction ids can also be files. FindParents doesn't consider them, so we merge it
-		ExcludeIdsWithout<CFileRef>(access, parentIds);
-		if (!parentIds.IsEmpty())
+		// Capture the state of the entities and their parents, since hierarchy and links are
+		// stored on both sides
+		auto& ast              = static_cast<Tree&>(access.GetContext());
+		gActiveTransaction.ast = &ast;
+		TArray<Id>& ids        = gActiveTransaction.undo.ids;
+		for (Id id : entityIds)
 		{
-			access.AddN<CFileDirty>(parentIds);
+			ids.AddUniqueSorted(id);
+			const Id parentId = p::GetParent(access, id);
+			if (!IsNone(parentId))
+			{
+				ids.AddUniqueSorted(parentId);
+			}
 		}
+		CaptureTrackedDeltas(ast, gActiveTransaction.undo);
 
-		// TODO: Capture AST state
+		// Used to find entities created by the transaction
+		for (Id id : ids)
+		{
+			p::GetChildren(ast, id, gActiveTransaction.childIds);
+		}
 		return true;
 	}
 
@@ -62,7 +338,119 @@ namespace rift::AST::Transactions
 		if (EnsureMsg(gActiveTransaction.active,
 		        "Cant finish a transaction while none is being recorded"))
 		{
+			if (gActiveTransaction.ast)
+			{
+				RecacheChangedNamespaces(*gActiveTransaction.ast, gActiveTransaction.undo.ids);
+				MarkEdited(*gActiveTransaction.ast);
+				RecordUndo(*gActiveTransaction.ast, Move(gActiveTransaction.undo),
+				    gActiveTransaction.childIds);
+			}
 			gActiveTransaction = {};
 		}
 	}
+
+	bool Undo(Tree& ast)
+	{
+		ZoneScoped;
+		if (!CanUndo(ast))
+		{
+			return false;
+		}
+
+		auto& history = ast.GetStatic<SUndoHistory>();
+		--history.undoable;
+		const i32 index = (history.first + history.undoable) % SUndoHistory::capacity;
+		UndoTransaction& transaction = history.transactions[index];
+
+		// Destroyed entities get new ids. References to them are remapped before restoring
+		Recreate(ast, history, transaction.destroyedIds);
+		for (auto& deltas : transaction.deltas)
+		{
+			deltas->Restore(ast, false);
+		}
+		Destroy(ast, transaction.createdIds);
+		MarkRestored(ast, transaction.ids);
+		return true;
+	}
+
+	bool Redo(Tree& ast)
+	{
+		ZoneScoped;
+		if (!CanRedo(ast))
+		{
+			return false;
+		}
+
+		auto& history = ast.GetStatic<SUndoHistory>();
+		const i32 index = (history.first + history.undoable) % SUndoHistory::capacity;
+		++history.undoable;
+		UndoTransaction& transaction = history.transactions[index];
+
+		Recreate(ast, history, transaction.createdIds);
+		for (auto& deltas : transaction.deltas)
+		{
+			deltas->Restore(ast, true);
+		}
+
+		TArray<Id> ids;
+		ids.Reserve(transaction.ids.Size() + transaction.createdIds.Size());
+		ids.Append(transaction.ids);
+		ids.Append(transaction.createdIds);
+		MarkRestored(ast, ids);
+
+		Destroy(ast, transaction.destroyedIds);
+		return true;
+	}
+
+	bool CanUndo(const Tree& ast)
+	{
+		const auto* history = ast.TryGetStatic<SUndoHistory>();
+		return history && history->undoable > 0;
+	}
+
+	bool CanRedo(const Tree& ast)
+	{
+		const auto* history = ast.TryGetStatic<SUndoHistory>();
+		return history && history->undoable < history->count;
+	}
+
+	void ClearHistory(Tree& ast)
+	{
+		if (ast.HasStatic<SUndoHistory>())
+		{
+			ast.SetStatic<SUndoHistory>();
+		}
+	}
+
+	void RemapHistory(Tree& ast, SUndoHistory& history, TMap<Id, Id>& remap)
+	{
+		auto addDeadId = [&ast, &remap](Id id) {
+			if (!IsNone(id) && !remap.Find(id))
+			{
+				// Destroyed ids are never reused by the tree
+				const Id deadId = ast.Create();
+				ast.Destroy(deadId);
+				remap.Insert(id, deadId);
+			}
+		};
+		for (UndoTransaction& transaction : history.transactions)
+		{
+			for (Id id : transaction.ids)
+			{
+				addDeadId(id);
+			}
+			for (Id id : transaction.destroyedIds)
+			{
+				addDeadId(id);
+			}
+			for (Id id : transaction.createdIds)
+			{
+				addDeadId(id);
+			}
+		}
+		for (UndoTransaction& transaction : history.transactions)
+		{
+			RemapIds(transaction, remap);
+		}
+	}
 }    // namespace rift::AST::Transactions
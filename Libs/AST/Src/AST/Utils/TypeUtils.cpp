@@ -24,8 +24,10 @@
 #include "AST/Components/CStmtReturn.h"
 #include "AST/Components/Views/CNodePosition.h"
 #include "AST/Statics/STypes.h"
+#include "AST/Utils/Hierarchy.h"
 #include "AST/Utils/Namespaces.h"
 #include "AST/Utils/Paths.h"
+#include "AST/Utils/References.h"
 #include "AST/Utils/TransactionUtils.h"
 #include "ASTModule.h"
 #include "Rift.h"
@@ -94,7 +96,7 @@ namespace rift::AST
 				}
 			}
 		}
-		p::Remove(access, typeIds, true);
+		RemoveWithChildren(access, typeIds);
 	}
 
 	void SerializeType(Tree& ast, Id id, String& data)
@@ -280,7 +282,7 @@ namespace rift::AST
 		TArray<Id> outIds(2);
 		ast.Create(outIds);
 		p::Attach(ast, id, outIds);
-		ast.Add<CStmtOutputs>(id, Move(outIds));
+		ast.Add<CStmtOutputs>(id, CStmtOutputs{outIds});
 
 		if (type)
 		{
@@ -462,8 +464,57 @@ namespace rift::AST
 
 	void RemoveNodes(const RemoveAccess& access, TView<Id> ids)
 	{
-		ScopedChange(access, ids);
-		p::Remove(access, ids, true);
+		// Undo must restore removed children and the links other nodes had into them
+		TArray<Id> changedIds;
+		changedIds.Append(ids);
+		GetAllChildren(static_cast<Tree&>(access.GetContext()), ids, changedIds);
+		changedIds.Sort([](Id one, Id other) {
+			return one < other;
+		});
+
+		TArray<Id> siblingIds;
+		for (Id id : ids)
+		{
+			const Id parentId = p::GetParent(access, id);
+			if (!IsNone(parentId))
+			{
+				p::GetChildren(access, parentId, siblingIds);
+			}
+		}
+		const auto isRemoved = [&changedIds](Id id) {
+			return changedIds.FindSortedEqual(id) != NO_INDEX;
+		};
+		TArray<Id> linkedIds;
+		for (Id siblingId : siblingIds)
+		{
+			if (isRemoved(siblingId))
+			{
+				continue;
+			}
+			bool linked = false;
+			if (const auto* inputs = access.TryGet<const CExprInputs>(siblingId))
+			{
+				for (const ExprOutput& output : inputs->linkedOutputs)
+				{
+					linked |= isRemoved(output.nodeId);
+				}
+			}
+			if (const auto* outputs = access.TryGet<const CStmtOutputs>(siblingId))
+			{
+				for (Id inputNodeId : outputs->linkInputNodes)
+				{
+					linked |= isRemoved(inputNodeId);
+				}
+			}
+			if (linked)
+			{
+				linkedIds.Add(siblingId);
+			}
+		}
+		changedIds.Append(linkedIds);
+
+		ScopedChange(access, changedIds);
+		RemoveWithChildren(access, ids);
 	}
 
 	bool CopyExpressionType(TAccessRef<TWrite<CExprTypeId>> access, Id sourcePinId, Id targetPinId)
@@ -479,6 +530,7 @@ namespace rift::AST
 		if (targetType)
 		{
 			*targetType = *sourceType;
+			MarkReferencesChanged<CExprTypeId>(static_cast<Tree&>(access.GetContext()), targetPinId);
 		}
 		else
 		{
@@ -5,6 +5,7 @@
 #include "AST/Systems/LoadSystem.h"
 #include "AST/Systems/TypeSystem.h"
 #include "AST/Utils/ModuleUtils.h"
+#include "AST/Utils/SystemScheduler.h"
 #include "Compiler/Backend.h"
 #include "Compiler/Systems/OptimizationSystem.h"
 #include "Rift.h"
@@ -21,45 +22,69 @@ namespace rift
 		CompileError newError{};
 		newError.text = str;
 		errors.Add(newError);
+		if (onError)
+		{
+			onError(errors.Last());
+		}
 	}
 
 
-	void Build(AST::Tree& ast, const CompilerConfig& config, TPtr<Backend> backend)
+	void Compiler::ReportProgress(StringView stage)
 	{
-		ZoneScoped;
-		Compiler compiler{ast, config};
+		p::Info(stage);
+		if (onProgress)
+		{
+			onProgress(stage);
+		}
+	}
+
 
+	void Build(Compiler& compiler, TPtr<Backend> backend)
+	{
+		ZoneScoped;
 		if (!backend)
 		{
 			compiler.AddError("Invalid backend.");
 			return;
 		}
 
+		AST::Tree& ast = compiler.ast;
 		{
 			ZoneScopedN("Frontend");
 
 			if (!AST::HasProject(ast))
 			{
-				p::Error("No existing project to build.");
+				compiler.AddError("No existing project to build.");
 				return;
 			}
 			compiler.config.Init(ast);
 
 			if (auto* nativeBindings = GetModule<NativeBindingModule>().Get())
 			{
-				p::Info("Interpret native modules");
+				compiler.ReportProgress("Interpret native modules");
 				nativeBindings->SyncIncludes(ast);
 			}
 
-			p::Info("Loading files");
+			compiler.ReportProgress("Loading files");
 			AST::LoadSystem::Run(ast);
-
-			OptimizationSystem::PruneDisconnectedExpressions(ast);
-			AST::TypeSystem::PropagateVariableTypes(ast);
-			AST::TypeSystem::PropagateExpressionTypes(ast);
+			if (compiler.IsCancelled())
+			{
+				return;
+			}
+			AST::SystemScheduler systems;
+			systems.Add(
+			    "PruneDisconnectedExpressions", &OptimizationSystem::PruneDisconnectedExpressions);
+			systems.Add("PropagateVariableTypes", &AST::TypeSystem::PropagateVariableTypes);
+			systems.Add("PropagateExpressionTypes", &AST::TypeSystem::PropagateExpressionTypes);
+			systems.Run(ast);
+		}
+		if (compiler.IsCancelled())
+		{
+			return;
 		}
 
-		p::Info("Building project '{}'", AST::GetProjectName(compiler.ast));
+		compiler.ReportProgress(
+		    Strings::Format("Building project '{}'", AST::GetProjectName(compiler.ast)));
 		// Clean build folders
 		p::Info("Cleaning previous build");
 		files::Delete(compiler.config.binariesPath, true, false);
@@ -68,6 +93,12 @@ namespace rift
 		backend->Build(compiler);
 	}
 
+	void Build(AST::Tree& ast, const CompilerConfig& config, TPtr<Backend> backend)
+	{
+		Compiler compiler{ast, config};
+		Build(compiler, backend);
+	}
+
 	void Build(AST::Tree& ast, const CompilerConfig& config, ClassType* backendType)
 	{
 		if (backendType)
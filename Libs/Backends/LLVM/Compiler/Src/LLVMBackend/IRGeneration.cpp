@@ -29,6 +29,10 @@ namespace rift::LLVM
 
 		for (AST::Id moduleId : FindAllIdsWith<AST::CModule>(access))
 		{
+			if (compiler.IsCancelled())
+			{
+				return;
+			}
 			GenerateIRModule(compiler, access, moduleId, llvm, builder);
 		}
 	}
@@ -149,7 +153,7 @@ namespace rift::LLVM
 		ZoneScoped;
 		for (AST::Id id : ids)
 		{
-			p::String name = AST::GetFullName(access, id);
+			const Tag name = AST::GetFullName(access, id);
 			access.Add(id, CIRType{llvm::StructType::create(gen.llvm, ToLLVM(name))});
 		}
 	}
@@ -218,8 +222,8 @@ namespace rift::LLVM
 					}
 					else
 					{
-						const Tag argName         = AST::GetName(access, inputId);
-						const String functionName = AST::GetFullName(access, id);
+						const Tag argName      = AST::GetName(access, inputId);
+						const Tag functionName = AST::GetFullName(access, id);
 						gen.compiler.AddError(Strings::Format(
 						    "Input '{}' in function '{}' has an invalid type. Using i32 instead.",
 						    argName, functionName));
@@ -229,8 +233,7 @@ namespace rift::LLVM
 			}
 
 			// Create function
-			p::String name = useFullName ? AST::GetFullName(access, id)
-			                             : p::String{AST::GetName(access, id).AsString()};
+			const Tag name = useFullName ? AST::GetFullName(access, id) : AST::GetName(access, id);
 			auto* functionType =
 			    llvm::FunctionType::get(gen.builder.getVoidTy(), ToLLVM(inputTypes), false);
 			functionComp.instance = llvm::Function::Create(
@@ -258,6 +261,11 @@ namespace rift::LLVM
 		ZoneScoped;
 		for (AST::Id id : ids)
 		{
+			if (gen.compiler.IsCancelled())
+			{
+				return;
+			}
+
 			const auto& irFunction = access.Get<const CIRFunction>(id);
 			auto* block = llvm::BasicBlock::Create(gen.llvm, "entry", irFunction.instance);
 
@@ -106,6 +106,10 @@ namespace rift
 
 			for (AST::Id moduleId : FindAllIdsWith<CIRModule>(compiler.ast))
 			{
+				if (compiler.IsCancelled())
+				{
+					return;
+				}
 				LLVM::SaveModuleObject(compiler, moduleId, targetMachine, targetTriple);
 			}
 		}
@@ -118,16 +122,17 @@ namespace rift
 		llvm::LLVMContext llvm;
 		llvm::IRBuilder<> builder(llvm);
 
-		p::Info("Generating LLVM IR");
+		compiler.ReportProgress("Generating LLVM IR");
 		LLVM::GenerateIR(compiler, llvm, builder);
-		if (compiler.HasErrors())
+		if (compiler.HasErrors() || compiler.IsCancelled())
 			return;    // TODO: Report errors here
 
-		p::Info("Build IR");
+		compiler.ReportProgress("Build IR");
 		LLVM::CompileIR(compiler, llvm, builder);
-		if (compiler.HasErrors())
+		if (compiler.HasErrors() || compiler.IsCancelled())
 			return;    // TODO: Report errors here
 
+		compiler.ReportProgress("Linking");
 		LLVM::Link(compiler);
 
 		compiler.ast.ClearPool<CIRModule>();
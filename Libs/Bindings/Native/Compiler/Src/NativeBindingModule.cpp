@@ -11,6 +11,8 @@
 #include <AST/Components/CModule.h>
 #include <AST/Id.h>
 #include <AST/Tree.h>
+#include <AST/Utils/ComponentIds.h>
+#include <AST/Utils/MemoryStats.h>
 #include <AST/Utils/ModuleUtils.h>
 #include <AST/Utils/TypeUtils.h>
 #include <clang-c/Index.h>
@@ -21,8 +23,24 @@
 // P_OVERRIDE_NEW_DELETE
 
 
+namespace rift::AST
+{
+	template<>
+	inline constexpr bool hasNoIds<CDeclCStruct> = true;
+	template<>
+	inline constexpr bool hasNoIds<CDeclCStatic> = true;
+	template<>
+	inline constexpr bool hasNoIds<CNativeBinding> = true;
+}    // namespace rift::AST
+
+
 namespace rift
 {
+	p::sizet GetHeapBytes(const CNativeBinding& binding)
+	{
+		return AST::GetHeapBytes(binding.binaries);
+	}
+
 	struct ParsedModule
 	{
 		AST::Id id    = AST::NoId;
@@ -54,6 +72,7 @@ namespace rift
 		typeSettings.hasFunctionBodies = false;
 		AST::RegisterFileType<CDeclCStatic>("CStatic", typeSettings);
 		AST::PreAllocPools<CDeclCStruct, CDeclCStatic>();
+		AST::RegisterCompactedPools<CNativeBinding>();
 
 		// Register module binding
 		AST::RegisterModuleBinding(
@@ -1,7 +1,11 @@
 // Copyright 2015-2023 Piperift - All rights reserved
 #pragma once
 
+#include "Tools/FrameProfiler.h"
+#include "Utils/BuildService.h"
+
 #include <AST/Tree.h>
+#include <AST/Utils/SystemScheduler.h>
 #include <Pipe/Files/Paths.h>
 #include <Pipe/Math/FrameTime.h>
 
@@ -13,13 +17,32 @@ namespace rift::Editor
 	class Editor
 	{
 		FrameTime frameTime;
+		// Frames still drawn before the editor can sleep waiting for events
+		i32 activeFrames = 0;
 
 		bool configFileChanged = false;
 		String configFile;
 
 		AST::Tree ast;
+		// Systems running before and after drawing the editor
+		AST::SystemScheduler preDrawSystems;
+		AST::SystemScheduler postDrawSystems;
+
+		BuildService buildService;
+		FrameProfiler profiler;
+
+		// Compaction replaces the tree, so it waits until nothing is drawing from it
+		bool compactionRequested = false;
 
 	public:
+		// Frames drawn after any input or activity before going idle
+		static constexpr i32 framesAfterActivity = 3;
+		// Max time the editor sleeps while idle. Some widgets (like text carets) still animate
+		static constexpr float idleTimeout          = 0.5f;
+		static constexpr float unfocusedIdleTimeout = 2.f;
+		// Time unfocused editors wait between active frames, unless an event arrives first
+		static constexpr float unfocusedFrameTime = 1.f / 20.f;
+
 #if P_DEBUG
 		bool showDemo    = false;
 		bool showMetrics = false;
@@ -49,12 +72,35 @@ namespace rift::Editor
 			return Get().ast;
 		}
 
+		BuildService& GetBuildService()
+		{
+			return buildService;
+		}
+
+		FrameProfiler& GetProfiler()
+		{
+			return profiler;
+		}
+
 		bool CreateProject(p::StringView path, bool closeFirst = true);
 		bool OpenProject(p::StringView path, bool closeFirst = true);
 
+		// Compacts the project tree at the start of the next frame. Cancels any build
+		void RequestCompaction()
+		{
+			compactionRequested = true;
+		}
+
 		void Close();
 
 	protected:
 		void UpdateConfig();
+		void SetupSystems();
+		void CompactProject();
+
+		// Sleeps until the next frame should be drawn
+		void WaitForActivity();
+		// @return true if the editor has pending work and can't go idle
+		bool IsBusy();
 	};
 }    // namespace rift::Editor
@@ -13,6 +13,12 @@
 #include <Pipe/PipeECS.h>
 
 
+namespace rift::AST
+{
+	struct IdRemap;
+}
+
+
 namespace rift::Editor
 {
 	// Forward declarations
@@ -40,14 +46,31 @@ namespace rift::Editor
 		struct Folder
 		{
 			p::TArray<Item> items;
+			bool sorted = false;
+			bool open   = false;
+		};
+
+		// Visible line of the explorer. Rebuilt when items change or folders open or close
+		struct Row
+		{
+			const Item* item = nullptr;
+			Folder* folder   = nullptr;    // Set if the item is a folder or a module
+			p::i32 depth     = 0;
 		};
 
 	private:
 		AST::Id projectModuleId = AST::NoId;
 		p::TMap<p::Tag, Folder> folders;
+		// Folder containing each type item
+		p::TMap<AST::Id, p::Tag> typeFolders;
+		p::TArray<Row> rows;
 
 		bool open  = true;
 		bool dirty = true;
+		// Rows must be rebuilt before drawing
+		bool rowsDirty = true;
+		// Types whose file was added, removed or changed since the last frame
+		p::TArray<AST::Id> pendingTypeIds;
 
 		Filter filter    = Filter::All;
 		AST::Id renameId = AST::NoId;
@@ -69,12 +92,27 @@ namespace rift::Editor
 
 		void CacheProjectFiles(
 		    p::TAccessRef<AST::CProject, AST::CModule, AST::CFileRef, AST::CDeclType> access);
+		// Updates only the types that changed since the last frame
+		void UpdateProjectFiles(
+		    p::TAccessRef<AST::CProject, AST::CModule, AST::CFileRef, AST::CDeclType> access);
 
 		void SortFolder(Folder& folder);
 
+		// Called when files or types are added, removed or changed
+		void OnTypesChanged(p::TView<const AST::Id> ids);
+		// Called when modules are added or removed. Rebuilds the whole tree
+		void OnModulesChanged();
+		// Called when the tree was compacted. Rebuilds the whole tree
+		void RemapIds(const AST::IdRemap& remap);
+
 	private:
 		void InsertItem(const Item& item);
-		void DrawItem(AST::Tree& ast, const Item& item);
+		void RemoveType(AST::Id id);
+		// Removes empty plain folders from a folder up
+		void PruneFolder(p::Tag folderName);
+		void CacheRows();
+		void AddFolderRows(Folder& folder, p::i32 depth);
+		void DrawItem(AST::Tree& ast, const Row& row);
 		// void DrawFile(AST::Tree& ast, File& file);
 
 		void DrawModuleActions(AST::Id id, struct AST::CModule& module);
@@ -7,5 +7,7 @@
 namespace rift::Editor::EditorSystem
 {
 	void Init(AST::Tree& ast);
+	// Binds hooks keeping editor state updated. Trees replacing the project tree need them again
+	void BindHooks(AST::Tree& ast);
 	void Draw(AST::Tree& ast);
 }    // namespace rift::Editor::EditorSystem
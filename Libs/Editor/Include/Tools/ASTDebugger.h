@@ -15,24 +15,51 @@
 #include <UI/UI.h>
 
 
+namespace rift::AST
+{
+	struct IdRemap;
+}
+
+
 namespace rift::Editor
 {
 	struct ASTDebugger
 	{
+		// Node shown in the nodes table. Rows are drawn flat, only the visible ones
+		struct Row
+		{
+			AST::Id id       = AST::NoId;
+			p::i32 depth     = 0;
+			bool hasChildren = false;
+		};
+
 		bool open          = false;
 		bool showHierarchy = true;
 
 		AST::Id selectedNode = AST::NoId;
 		ImGuiTextFilter filter;
 
+		p::TArray<Row> rows;
+		// Nodes open in the hierarchy
+		p::TArray<AST::Id> expandedIds;
+		// Rows must be rebuilt before drawing
+		bool rowsDirty = true;
+		// Versions of the pools rows depend on when they were last cached
+		p::u64 rowsVersion = 0;
+
 
 		ASTDebugger();
 
 		void Draw(AST::Tree& ast);
+		// Called when the tree was compacted
+		void RemapIds(const AST::IdRemap& remap);
 
 	private:
 		using DrawNodeAccess =
 		    p::TAccessRef<AST::CNamespace, AST::CFileRef, AST::CParent, AST::CChild, AST::CModule>;
-		void DrawNode(DrawNodeAccess access, AST::Id nodeId, bool showChildren);
+		void CacheRows(AST::Tree& ast);
+		void AddNodeRows(DrawNodeAccess access, AST::Id nodeId, p::i32 depth);
+		bool PassFilter(DrawNodeAccess access, AST::Id nodeId) const;
+		void DrawNode(DrawNodeAccess access, const Row& row);
 	};
 }    // namespace rift::Editor
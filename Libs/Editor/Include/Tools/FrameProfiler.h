@@ -0,0 +1,71 @@
+// Copyright 2015-2023 Piperift - All rights reserved
+#pragma once
+
+#include <AST/Utils/SystemScheduler.h>
+#include <Pipe/Core/Platform.h>
+#include <Pipe/Core/String.h>
+#include <Pipe/Core/StringView.h>
+#include <Pipe/PipeArrays.h>
+
+#include <chrono>
+
+
+namespace rift::Editor
+{
+	using namespace p;
+
+
+	/**
+	 * Times the steps of each editor frame and keeps a rolling history of them.
+	 * Unlike Tracy, it is always available, so it can be used on any machine.
+	 */
+	struct FrameProfiler
+	{
+		using Clock                      = std::chrono::steady_clock;
+		static constexpr i32 historySize = 120;
+
+		struct Step
+		{
+			String name;
+			i32 depth = 0;
+			// Milliseconds spent on each frame. Indexed like historyIndex
+			float history[historySize]{};
+		};
+
+		// Times a step of the frame while in scope. Steps can be nested
+		struct Scope
+		{
+			FrameProfiler& profiler;
+			i32 stepIndex;
+			Clock::time_point start;
+
+			Scope(FrameProfiler& profiler, StringView name);
+			~Scope();
+		};
+
+		bool open   = false;
+		bool paused = false;
+
+	private:
+		TArray<Step> steps;
+		// Indices of steps in the order they are shown
+		TArray<i32> order;
+		i32 historyIndex  = 0;
+		i32 depth         = 0;
+		i32 lastStepIndex = NO_INDEX;
+
+
+	public:
+		void BeginFrame();
+		// Adds time to a step timed without a Scope
+		void Record(StringView name, float time);
+		// Adds the time of each system on the last run of a scheduler
+		void RecordSystems(const AST::SystemScheduler& scheduler);
+
+		void Draw();
+
+	private:
+		i32 BeginStep(StringView name);
+		void EndStep(i32 stepIndex, float time);
+	};
+}    // namespace rift::Editor
@@ -2,10 +2,13 @@
 #pragma once
 
 #include <Pipe/Core/Platform.h>
+#include <Pipe/Core/String.h>
 #include <Pipe/Core/StringView.h>
 #include <Pipe/Math/Vector.h>
 #include <Pipe/Memory/BigBestFitArena.h>
 #include <Pipe/Memory/Block.h>
+#include <Pipe/PipeArrays.h>
+#include <UI/UI.h>
 
 
 namespace rift::Editor
@@ -15,10 +18,31 @@ namespace rift::Editor
 
 	struct MemoryDebugger
 	{
+		struct Allocation
+		{
+			const void* ptr = nullptr;
+			sizet size      = 0;
+		};
+
 		bool open = false;
 
+		ImGuiTextFilter filter;
+		// Allocations passing the filter. Allocations change every frame, so this is a snapshot
+		// taken when the filter changes or on refresh
+		TArray<Allocation> filtered;
+		bool filterDirty = true;
+
+		// Only the selected allocation shows its details
+		const void* selectedPtr = nullptr;
+		sizet selectedSize      = 0;
+		TArray<String> selectedStack;
+
 
 		MemoryDebugger();
 		void Draw();
+
+	private:
+		void Select(const Allocation& allocation);
+		void DrawDetails();
 	};
 }    // namespace rift::Editor
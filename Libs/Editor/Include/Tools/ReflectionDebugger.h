@@ -19,12 +19,19 @@ namespace rift::Editor
 		ImGuiTextFilter filter;
 		TypeCategory categoryFilter = TypeCategory::All;
 
+		// Types passing the filters. Only the visible ones are drawn
+		TArray<Type*> rows;
+		// Rows must be rebuilt before drawing
+		bool rowsDirty = true;
+
 
 		ReflectionDebugger();
 
 		void Draw();
 
 	private:
+		void CacheRows();
+		bool PassFilter(Type* type) const;
 		void DrawType(Type* type);
 	};
 }    // namespace rift::Editor
@@ -0,0 +1,83 @@
+// Copyright 2015-2023 Piperift - All rights reserved
+#pragma once
+
+#include <AST/Tree.h>
+#include <AST/Utils/Snapshots.h>
+#include <Compiler/CompilerConfig.h>
+#include <Pipe/Memory/OwnPtr.h>
+#include <Pipe/PipeArrays.h>
+#include <UI/Notify.h>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+
+namespace rift::Editor
+{
+	/**
+	 * Builds a copy of the project on a background thread while the editor keeps running.
+	 * Errors are shown as notifications while building and the current stage is shown in the
+	 * menu bar. Editing the tree during a build cancels it and starts it again if restartOnEdit
+	 * is enabled.
+	 */
+	class BuildService
+	{
+		std::thread thread;
+		std::atomic<bool> building  = false;
+		std::atomic<bool> cancelled = false;
+
+		// Tree being built. Copied on the build thread from a snapshot of the project
+		p::TOwnPtr<AST::Tree> tree;
+		// Released once copied. The project can't be reset while it is being read
+		std::mutex snapshotMutex;
+		AST::TreeSnapshot snapshot;
+		// Edit version of the project when the build started
+		p::u64 editVersion = 0;
+		// Settings to build again
+		p::ClassType* backendType = nullptr;
+		CompilerConfig config;
+		bool pendingRestart = false;
+
+		// Notifications produced by the build thread. Drained on the main thread
+		std::mutex toastsMutex;
+		p::TArray<UI::Toast> pendingToasts;
+		// Stage being built. Set from the build thread
+		mutable std::mutex stageMutex;
+		p::String stage;
+
+		// Errors shown as notifications per build. The rest are only logged
+		static constexpr p::i32 maxErrorToasts = 5;
+
+	public:
+		bool restartOnEdit = true;
+
+
+	public:
+		BuildService() = default;
+		~BuildService();
+		BuildService(const BuildService&)            = delete;
+		BuildService& operator=(const BuildService&) = delete;
+
+		// Starts a build, cancelling the current one if any
+		void Start(AST::Tree& ast, p::ClassType* backendType, const CompilerConfig& config = {});
+		// Cancels the current build. Once it returns, the project is not read by the build and
+		// can be reset or closed
+		void Cancel();
+
+		// Must be called every frame from the main thread
+		void Tick(AST::Tree& ast);
+
+		bool IsBuilding() const
+		{
+			return building;
+		}
+		p::String GetStage() const;
+
+	private:
+		void Run();
+		void Join();
+		void SetStage(p::StringView newStage);
+		void Notify(UI::ToastType type, p::String message);
+	};
+}    // namespace rift::Editor
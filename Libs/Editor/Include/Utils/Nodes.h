@@ -3,6 +3,7 @@
 
 #include <AST/Id.h>
 #include <Pipe/Core/EnumFlags.h>
+#include <Pipe/Core/StringView.h>
 #include <Pipe/Math/Color.h>
 #include <Pipe/Math/Vector.h>
 #include <UI/UIImgui.h>
@@ -248,6 +249,12 @@ namespace rift::Nodes
 		// Offsets the pins' positions from the edge of the node to the outside of the node.
 		float PinOffset;
 
+		// Zoom limits of the canvas. Zoom is the amount of screen units per grid unit.
+		float minZoom = 0.1f;
+		float maxZoom = 1.f;
+		// Below this zoom nodes are drawn as simplified boxes without widgets or pins.
+		float detailZoom = 0.5f;
+
 		// Mini-map padding size between mini-map edge and mini-map content.
 		v2 miniMapPadding{8.f, 8.f};
 		// Mini-map offset from the screen side.
@@ -298,6 +305,9 @@ namespace rift::Nodes
 	void SetEditorContext(EditorContext*);
 	v2 GetPanning();
 	void ResetPanning(const v2& pos);
+	float GetZoom();
+	// Zooms around the center of the canvas
+	void SetZoom(float zoom);
 	void MoveToNode(AST::Id nodeId, v2 offset = v2::Zero());
 
 	IO& GetIO();
@@ -344,6 +354,15 @@ namespace rift::Nodes
 
 	v2 GetNodeDimensions(AST::Id id);
 
+	// Nodes out of the visible canvas can be kept instead of laid out with BeginNode/EndNode.
+	// Kept nodes reuse their last layout for selection, links and the minimap.
+	// @return true if the node overlaps the visible canvas or has not been laid out yet
+	bool IsNodeVisible(AST::Id id);
+	// @return true if the node must be laid out. False if culled or too zoomed out for detail
+	bool ShouldLayoutNode(AST::Id id);
+	// Visible kept nodes are drawn as simplified boxes with an optional title
+	void KeepNode(AST::Id id, StringView title = {});
+
 	// Place your node title bar content (such as the node title, using ImGui::Text) between the
 	// following function calls. These functions have to be called before adding any attributes,
 	// or the layout of the node will be incorrect.
@@ -375,6 +394,8 @@ namespace rift::Nodes
 	// function calls. The order of start_attr and end_attr doesn't make a difference for
 	// rendering the link.
 	void Link(Id id, Id outputPin, Id inputPin);
+	// @return true if the last curve of the link overlaps the visible canvas
+	bool IsLinkVisible(Id id);
 
 	// Enable or disable the ability to click and drag a specific node.
 	void SetNodeDraggable(Id nodeId, const bool draggable);
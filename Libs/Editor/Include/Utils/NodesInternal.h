@@ -10,6 +10,7 @@
 #include <limits.h>
 #include <Pipe/Core/BitArray.h>
 #include <Pipe/Core/EnumFlags.h>
+#include <Pipe/Core/Map.h>
 #include <Pipe/Math/Vector.h>
 #include <Pipe/PipeArrays.h>
 
@@ -285,11 +286,55 @@ namespace rift::Nodes
 	};
 
 
+	/**
+	 * Uniform grid of rects in grid space used to hit test nodes, pins and links. Since grid
+	 * space doesn't change with panning, entries only move between cells when their content
+	 * moves. Queries only visit the cells overlapping the queried area.
+	 */
+	struct SpatialGrid
+	{
+		struct CellRange
+		{
+			i32 minX = 0;
+			i32 minY = 0;
+			i32 maxX = -1;
+			i32 maxY = -1;
+
+			bool operator==(const CellRange& other) const = default;
+		};
+
+		static constexpr float cellSize = 256.f;
+
+		TMap<u64, TArray<i32>> cells;
+		// Rect and cells of each entry by entry index
+		TArray<Rect> rects;
+		TArray<CellRange> ranges;
+		TArray<bool> inserted;
+		// Used to return each entry once per query
+		TArray<u32> queryMarks;
+		u32 queryMark = 0;
+
+
+		void Update(i32 entry, const Rect& rect);
+		void Remove(i32 entry);
+		// Appends entries whose rect overlaps rect. Results may contain stale entries of
+		// objects not submitted this frame
+		void Query(const Rect& rect, TArray<i32>& results);
+		void Clear();
+
+	private:
+		CellRange GetCellRange(const Rect& rect) const;
+	};
+
+
 	struct NodeData
 	{
-		v2 Origin = v2::Zero();    // The node origin is in editor space
+		AST::Id id = AST::NoId;
+		v2 Origin  = v2::Zero();    // The node origin is in editor space
 		Rect TitleBarContentRect;
 		Rect rect{v2::Zero(), v2::Zero()};
+		// Size of the last layout in grid space. Zero if never laid out
+		v2 gridSize = v2::Zero();
 
 		struct
 		{
@@ -307,6 +352,10 @@ namespace rift::Nodes
 		ImVector<i32> inputs;
 		ImVector<i32> outputs;
 		bool Draggable = true;
+		// Kept this frame without layout (see KeepNode)
+		bool culled = false;
+		// Title drawn on kept nodes. Only valid during the frame
+		StringView simplifiedTitle;
 
 
 		NodeData() {}
@@ -319,7 +368,8 @@ namespace rift::Nodes
 		AST::Id parentNodeId = AST::NoId;
 		Rect rect;
 		PinShape Shape = PinShape_CircleFilled;
-		v2 position;    // screen-space coordinates
+		v2 position;        // screen-space coordinates
+		v2 gridPosition;    // grid-space coordinates
 		i32 Flags = PinFlags_None;
 
 		struct
@@ -344,6 +394,22 @@ namespace rift::Nodes
 		LinkData(const Id linkId = NoId()) : id(linkId) {}
 	};
 
+	// Link curve in grid space, cached across frames. Only rebuilt when its endpoints or the
+	// link style change
+	struct LinkGeometry
+	{
+		v2 start;
+		v2 end;
+		float segmentsPerLength = -1.f;
+		float hoverDistance     = -1.f;
+
+		CubicBezier bezier;
+		// Tessellated curve. numSegments + 1 points
+		TArray<v2> points;
+		// Expanded by the hover distance
+		Rect bounds;
+	};
+
 	struct ClickInteractionState
 	{
 		ClickInteractionType type;
@@ -400,6 +466,8 @@ namespace rift::Nodes
 
 		// ui related fields
 		v2 panning = v2::Zero();
+		// Screen units per grid unit
+		float zoom = 1.f;
 		v2 AutoPanningDelta;
 		// Minimum and maximum extents of all content in grid space. Valid after final
 		// Nodes::EndNode() call.
@@ -417,6 +485,15 @@ namespace rift::Nodes
 
 		MiniMap miniMap;
 
+		// Spatial indices of nodes (by id index), pins and links (by pool index)
+		SpatialGrid nodeGrid;
+		SpatialGrid outputGrid;
+		SpatialGrid inputGrid;
+		SpatialGrid linkGrid;
+
+		// Curves of the links by link pool index
+		TArray<LinkGeometry> linkGeometries;
+
 		bool canCreateLinks = true;
 
 
@@ -438,6 +515,10 @@ namespace rift::Nodes
 				case PinType::Input: return inputs;
 			}
 		}
+		SpatialGrid& GetPinGrid(PinType type)
+		{
+			return type == PinType::Input ? inputGrid : outputGrid;
+		}
 		PinData& GetPinData(PinIdx pin)
 		{
 			// TODO: Incompatible id types!
@@ -457,10 +538,17 @@ namespace rift::Nodes
 
 		// Canvas draw list and helper state
 		ImDrawList* CanvasDrawList;
-		ImGuiStorage NodeIdxToSubmissionIdx;
+		// Submission index of each node by id index. NO_INDEX if not submitted this frame
+		TArray<i32> nodeIdxToSubmissionIdx;
 		ImVector<AST::Id> nodeSubmissionOrder;
 		ImVector<AST::Id> nodeIdsOverlappingWithMouse;
-		ImVector<PinIdx> occludedPinIndices;
+		// Depth order of the nodes laid out this frame
+		TArray<AST::Id> submittedDepthOrder;
+		// Submission index of the node at each depth, used to sort node channels
+		TArray<i32> depthToSubmissionIdx;
+		// Entries returned by spatial grid queries
+		TArray<i32> gridQueryResults;
+		TArray<i32> occlusionQueryResults;
 
 		// Canvas extents
 		v2 CanvasOriginScreenSpace;
@@ -586,4 +674,7 @@ namespace rift::Nodes
 		const int index = ObjectPoolFindOrCreateIndex(objects, id);
 		return objects.pool[index];
 	}
+
+	// @return the cached curve of a link, rebuilt if it moved
+	const LinkGeometry& GetLinkGeometry(EditorContext& editor, const i32 linkIdx);
 }    // namespace rift::Nodes
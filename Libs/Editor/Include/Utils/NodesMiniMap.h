@@ -4,7 +4,10 @@
 
 #include <AST/Id.h>
 #include <Pipe/Core/Platform.h>
+#include <Pipe/Math/Color.h>
 #include <Pipe/Math/Vector.h>
+#include <Pipe/PipeArrays.h>
+#include <UI/UIImgui.h>
 
 
 namespace rift::Nodes
@@ -40,13 +43,40 @@ namespace rift::Nodes
 		Rect contentScreenSpace;
 		float scaling = 0.f;
 
+		// Draw data of all nodes and links in mini-map content space. Only rebuilt when the
+		// graph or the layout changes. Copied into the canvas otherwise.
+		ImDrawList* cachedDrawList = nullptr;
+		// State the cached draw data was built from
+		TArray<AST::Id> cachedNodeIds;
+		TArray<Rect> cachedNodeRects;      // grid-space
+		TArray<v2> cachedLinkEndpoints;    // grid-space. Start and end of each link
+		v2 cachedGridMin;
+		v2 cachedContentSize;
+		float cachedScaling = 0.f;
+		u32 cachedStyleHash = 0;
+
+
+		MiniMap() = default;
+		MiniMap(const MiniMap&) = delete;
+		MiniMap& operator=(const MiniMap&) = delete;
+		~MiniMap();
+
 		bool IsActive() const;
 		bool IsHovered() const;
 		void CalculateLayout();
 
-		void DrawNode(EditorContext& editor, const AST::Id nodeId);
-		void DrawLink(EditorContext& editor, const i32 linkIdx);
+		void DrawNode(ImDrawList* drawList, const v2& offset, EditorContext& editor,
+		    const AST::Id nodeId, const Color& background);
+		void DrawLink(ImDrawList* drawList, const v2& offset, EditorContext& editor,
+		    const i32 linkIdx, const Color& color);
 		void Update();
+
+	private:
+		// @return true if nodes, links, layout or style changed since the last cache build
+		bool UpdateCachedState(EditorContext& editor);
+		void RebuildCache(EditorContext& editor);
+		// Appends the cached draw data to the canvas at the mini-map position
+		void DrawCache();
 	};
 
 	// Add a navigable minimap to the editor; call before EndNodeEditor after all
@@ -4,25 +4,96 @@
 
 #include "AST/Systems/FunctionsSystem.h"
 #include "AST/Utils/Namespaces.h"
+#include "Components/CDeclRename.h"
+#include "Components/CModuleEditor.h"
+#include "Components/CTypeEditor.h"
 #include "Statics/SEditor.h"
 #include "Systems/EditorSystem.h"
 #include "Utils/FunctionGraph.h"
 
+#include <AST/Statics/SLoadQueue.h>
 #include <AST/Statics/SModules.h>
 #include <AST/Systems/FunctionsSystem.h>
 #include <AST/Systems/LoadSystem.h>
 #include <AST/Systems/TransactionSystem.h>
 #include <AST/Systems/TypeSystem.h>
+#include <AST/Utils/Compaction.h>
+#include <AST/Utils/MemoryStats.h>
 #include <AST/Utils/ModuleUtils.h>
 #include <Pipe/Core/Log.h>
 #include <Pipe/Core/Profiler.h>
 #include <Pipe/Files/Files.h>
 #include <UI/Inspection.h>
+#include <UI/Notify.h>
 #include <UI/Window.h>
 
 
+namespace rift::AST
+{
+	template<>
+	inline constexpr bool hasNoIds<Editor::CModuleEditor> = true;
+	template<>
+	inline constexpr bool hasNoIds<Editor::CDeclRename> = true;
+}    // namespace rift::AST
+
+
 namespace rift::Editor
 {
+	// Type editors keep their layout and view. Graph nodes are cached again by id
+	void CopyTypeEditors(AST::Tree& source, AST::Tree& target, const AST::IdRemap& remap)
+	{
+		for (AST::Id id : FindAllIdsWith<CTypeEditor>(source))
+		{
+			const AST::Id newId = remap.Get(id);
+			if (AST::IsNone(newId))
+			{
+				continue;
+			}
+
+			CTypeEditor editor             = source.Get<const CTypeEditor>(id);
+			editor.selectedPropertyId      = remap.Get(editor.selectedPropertyId);
+			editor.pendingDeletePropertyId = remap.Get(editor.pendingDeletePropertyId);
+			const v2 panning               = editor.nodesEditor.panning;
+			const float zoom               = editor.nodesEditor.zoom;
+			editor.nodesEditor             = {};
+			editor.nodesEditor.panning     = panning;
+			editor.nodesEditor.zoom        = zoom;
+			target.Add(newId, Move(editor));
+		}
+	}
+
+	// Only the largest arrays of the node editor are counted
+	p::sizet GetHeapBytes(const CTypeEditor& editor)
+	{
+		const Nodes::EditorContext& nodes = editor.nodesEditor;
+		return nodes.nodes.data.Size() * sizeof(Nodes::NodeData)
+		     + (nodes.outputs.pool.Size() + nodes.inputs.pool.Size()) * sizeof(Nodes::PinData)
+		     + nodes.links.pool.Size() * sizeof(Nodes::LinkData)
+		     + nodes.linkGeometries.Size() * sizeof(Nodes::LinkGeometry);
+	}
+
+	p::sizet GetHeapBytes(const CDeclRename& rename)
+	{
+		return AST::GetHeapBytes(rename.buffer);
+	}
+
+	void RemapStaticIds(SEditor& editor, const AST::IdRemap& remap)
+	{
+		AST::RemapStaticIds(editor.pendingTypesToClose, remap);
+		editor.fileExplorer.RemapIds(remap);
+		editor.astDebugger.RemapIds(remap);
+	}
+
+	// Editor state is kept when the project is compacted
+	void RegisterCompactedEditorState()
+	{
+		AST::GetCompactedPools().Add({p::GetTypeId<CTypeEditor>(),
+		    &AST::GetCompactedPoolIds<CTypeEditor>, &CopyTypeEditors,
+		    &AST::GetPoolMemoryStats<CTypeEditor>});
+		AST::RegisterUntrackedPools<CModuleEditor, CDeclRename>();
+		AST::RegisterCompactedStatics<SEditor>();
+	}
+
 	void RegisterKeyValueInspections()
 	{
 		UI::RegisterCustomInspection<AST::Id>([](StringView label, void* data, Type* type) {
@@ -57,6 +128,8 @@ namespace rift::Editor
 		}
 		Graph::Init();
 		RegisterKeyValueInspections();
+		SetupSystems();
+		RegisterCompactedEditorState();
 		p::Info("Editor is ready");
 
 		// Open a project if a path has been provided
@@ -64,13 +137,27 @@ namespace rift::Editor
 
 		while (!UI::WantsToClose())
 		{
+			profiler.BeginFrame();
+			{
+				FrameProfiler::Scope scope{profiler, "Idle"};
+				WaitForActivity();
+			}
 			frameTime.PreTick();
 
-			UI::PreFrame();
-			UpdateConfig();
+			{
+				FrameProfiler::Scope frameScope{profiler, "Frame"};
+				{
+					FrameProfiler::Scope scope{profiler, "UI::PreFrame"};
+					UI::PreFrame();
+				}
+				UpdateConfig();
 
-			Tick();
-			UI::Render();
+				Tick();
+				{
+					FrameProfiler::Scope scope{profiler, "UI::Render"};
+					UI::Render();
+				}
+			}
 
 			frameTime.PostTick();
 			FrameMark;
@@ -88,28 +175,84 @@ namespace rift::Editor
 
 	void Editor::Tick()
 	{
+		if (compactionRequested)
+		{
+			compactionRequested = false;
+			CompactProject();
+		}
+		{
+			FrameProfiler::Scope scope{profiler, "BuildService::Tick"};
+			buildService.Tick(ast);
+		}
 		if (AST::HasProject(ast))
 		{
-			AST::FunctionsSystem::ClearAddedTags(ast);
-			AST::TransactionSystem::ClearTags(ast);
-
-			AST::LoadSystem::Run(ast);
-			AST::FunctionsSystem::ResolveCallFunctionIds(ast);
-			AST::TypeSystem::ResolveExprTypeIds(ast);
-
-			EditorSystem::Draw(ast);
-			AST::TypeSystem::PropagateVariableTypes(ast);
-			AST::FunctionsSystem::PropagateDirtyIntoCalls(ast);
-			AST::FunctionsSystem::PushInvalidPinsBack(ast);
-			AST::FunctionsSystem::SyncCallPinsFromFunction(ast);
-			AST::TypeSystem::PropagateExpressionTypes(ast);
+			{
+				FrameProfiler::Scope scope{profiler, "Pre Draw Systems"};
+				preDrawSystems.Run(ast);
+				profiler.RecordSystems(preDrawSystems);
+			}
+			{
+				FrameProfiler::Scope scope{profiler, "EditorSystem::Draw"};
+				EditorSystem::Draw(ast);    // UI must run on the main thread
+			}
+			{
+				FrameProfiler::Scope scope{profiler, "Post Draw Systems"};
+				postDrawSystems.Run(ast);
+				profiler.RecordSystems(postDrawSystems);
+			}
 		}
 		else
 		{
+			FrameProfiler::Scope scope{profiler, "EditorSystem::Draw"};
 			EditorSystem::Draw(ast);
 		}
 	}
 
+	void Editor::SetupSystems()
+	{
+		preDrawSystems.Add("ClearAddedTags", &AST::FunctionsSystem::ClearAddedTags);
+		preDrawSystems.Add("ClearTags", &AST::TransactionSystem::ClearTags);
+		preDrawSystems.Add("Load", &AST::LoadSystem::Run);
+		preDrawSystems.Add(
+		    "ResolveCallFunctionIds", &AST::FunctionsSystem::ResolveCallFunctionIds);
+		preDrawSystems.Add("ResolveExprTypeIds", &AST::TypeSystem::ResolveExprTypeIds);
+
+		postDrawSystems.Add("PropagateVariableTypes", &AST::TypeSystem::PropagateVariableTypes);
+		postDrawSystems.Add(
+		    "PropagateDirtyIntoCalls", &AST::FunctionsSystem::PropagateDirtyIntoCalls);
+		postDrawSystems.Add("PushInvalidPinsBack", &AST::FunctionsSystem::PushInvalidPinsBack);
+		postDrawSystems.Add(
+		    "SyncCallPinsFromFunction", &AST::FunctionsSystem::SyncCallPinsFromFunction);
+		postDrawSystems.Add(
+		    "PropagateExpressionTypes", &AST::TypeSystem::PropagateExpressionTypes);
+	}
+
+	void Editor::CompactProject()
+	{
+		if (!AST::HasProject(ast))
+		{
+			return;
+		}
+
+		// Builds read snapshots of the tree, which compaction drops
+		buildService.Cancel();
+		const AST::TreeMemoryStats before = AST::GetMemoryStats(ast);
+		if (!AST::CompactTree(ast))
+		{
+			UI::AddNotification({UI::ToastType::Error, 3.f,
+			    "Compaction failed: A component pool is not registered"});
+			return;
+		}
+		// Hooks bound to the previous tree are lost
+		EditorSystem::BindHooks(ast);
+
+		const AST::TreeMemoryStats after = AST::GetMemoryStats(ast);
+		UI::AddNotification({UI::ToastType::Info, 3.f,
+		    Strings::Format("Compacted project: {} -> {} in pools",
+		        Strings::ParseMemorySize(before.GetPoolBytes()),
+		        Strings::ParseMemorySize(after.GetPoolBytes()))});
+	}
+
 	void Editor::SetUIConfigFile(Path path)
 	{
 		if (UI::GetWindow())
@@ -127,6 +270,8 @@ namespace rift::Editor
 			return false;
 		}
 
+		// Builds of the previous project are not restarted
+		buildService.Cancel();
 		if (AST::CreateProject(ast, path) && AST::OpenProject(ast, path))
 		{
 			ast.SetStatic<SEditor>();
@@ -144,6 +289,8 @@ namespace rift::Editor
 			return false;
 		}
 
+		// Builds of the previous project are not restarted
+		buildService.Cancel();
 		if (AST::OpenProject(ast, path))
 		{
 			ast.SetStatic<SEditor>();
@@ -159,6 +306,45 @@ namespace rift::Editor
 		rift::UI::Close();
 	}
 
+	void Editor::WaitForActivity()
+	{
+		ZoneScoped;
+		if (IsBusy())
+		{
+			activeFrames = framesAfterActivity;
+		}
+
+		const bool focused = UI::IsFocused();
+		if (activeFrames > 0)
+		{
+			--activeFrames;
+			if (!focused && UI::WaitEvents(unfocusedFrameTime))
+			{
+				activeFrames = framesAfterActivity;
+			}
+			return;
+		}
+
+		// Input, notifications and background tasks (with UI::WakeUp) end the wait
+		if (UI::WaitEvents(focused ? idleTimeout : unfocusedIdleTimeout))
+		{
+			activeFrames = framesAfterActivity;
+		}
+	}
+
+	bool Editor::IsBusy()
+	{
+		if (configFileChanged || UI::HasNotifications())
+		{
+			return true;
+		}
+		if (const auto* loadQueue = ast.TryGetStatic<AST::SLoadQueue>())
+		{
+			return !loadQueue->pendingSyncLoad.IsEmpty() || !loadQueue->pendingAsyncLoad.IsEmpty();
+		}
+		return false;
+	}
+
 	void Editor::UpdateConfig()
 	{
 		if (configFileChanged)
@@ -10,6 +10,7 @@
 #include "Utils/TypeUtils.h"
 
 #include <AST/Statics/STypes.h>
+#include <AST/Utils/Compaction.h>
 #include <AST/Utils/ModuleUtils.h>
 #include <AST/Utils/Paths.h>
 #include <AST/Utils/TransactionUtils.h>
@@ -71,10 +72,18 @@ namespace rift::Editor
 	void FileExplorerPanel::DrawList(AST::Tree& ast)
 	{
 		ZoneScoped;
-		// if (dirty)
+		if (dirty)
 		{
 			CacheProjectFiles(ast);
 		}
+		else
+		{
+			UpdateProjectFiles(ast);
+		}
+		if (rowsDirty)
+		{
+			CacheRows();
+		}
 
 		UI::BeginChild("Files");
 		if (UI::BeginPopupContextWindow())
@@ -86,9 +95,15 @@ namespace rift::Editor
 
 		{
 			ZoneScopedN("Draw Files");
-			for (auto& item : folders[{}].items)
+			// Only visible rows are drawn
+			ImGuiListClipper clipper;
+			clipper.Begin(rows.Size());
+			while (clipper.Step())
 			{
-				DrawItem(ast, item);
+				for (i32 i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
+				{
+					DrawItem(ast, rows[i]);
+				}
 			}
 		}
 		UI::EndChild();
@@ -186,10 +201,15 @@ namespace rift::Editor
 	{
 		StringView parentPath = p::GetParentPath(item.path);
 		Tag parentName{parentPath};
+		if (!item.isFolder)
+		{
+			typeFolders.Insert(item.id, parentName);
+		}
 
 		if (Folder* parent = folders.Find(parentName))
 		{
 			parent->items.Add(item);
+			parent->sorted = false;
 			return;
 		}
 		folders.Insert(parentName, Folder{.items = {item}});
@@ -205,6 +225,7 @@ namespace rift::Editor
 			if (Folder* parent = folders.Find(parentName))
 			{
 				parent->items.Add(newItem);
+				parent->sorted = false;
 				// Found an existing folder. Leave since we assume all parent folders are valid
 				return;
 			}
@@ -212,13 +233,75 @@ namespace rift::Editor
 		}
 	}
 
+	void FileExplorerPanel::RemoveType(AST::Id id)
+	{
+		const Tag* folderName = typeFolders.Find(id);
+		if (!folderName)
+		{
+			return;
+		}
+		const Tag name = *folderName;
+		typeFolders.Remove(id);
+
+		if (Folder* folder = folders.Find(name))
+		{
+			folder->items.RemoveIf([id](const Item& item) {
+				return !item.isFolder && item.id == id;
+			});
+			PruneFolder(name);
+		}
+	}
+
+	void FileExplorerPanel::PruneFolder(Tag folderName)
+	{
+		Folder* folder = folders.Find(folderName);
+		while (folder && folder->items.IsEmpty() && !folderName.IsNone())
+		{
+			const StringView path = folderName.AsString();
+			const Tag parentName{p::GetParentPath(path)};
+			Folder* parent = folders.Find(parentName);
+			if (!parent)
+			{
+				return;
+			}
+
+			// Module folders are kept even if empty
+			const i32 index = parent->items.FindIndex([path](const Item& item) {
+				return item.isFolder && IsNone(item.id) && item.path == path;
+			});
+			if (index == NO_INDEX)
+			{
+				return;
+			}
+			parent->items.RemoveAt(index);
+			folders.Remove(folderName);
+
+			folderName = parentName;
+			folder     = parent;
+		}
+	}
+
 	void FileExplorerPanel::CacheProjectFiles(
 	    TAccessRef<AST::CProject, AST::CModule, AST::CFileRef, AST::CDeclType> access)
 	{
 		ZoneScoped;
-		dirty = false;
+		dirty     = false;
+		rowsDirty = true;
+		pendingTypeIds.Clear(false);
+
+		// Keep folders open after the rebuild
+		const bool firstBuild = folders.Size() == 0;
+		TArray<Tag> openFolders;
+		for (const auto& it : folders)
+		{
+			if (it.second.open)
+			{
+				openFolders.Add(it.first);
+			}
+		}
 
 		folders.Clear();
+		typeFolders.Clear();
 
 		// Set root folder (not displayed)
 		folders.InsertDefaulted({});
@@ -227,41 +310,45 @@ namespace rift::Editor
 
 		// Create module folders
 		TArray<AST::Id> modules = FindAllIdsWith<AST::CModule>(access);
-		TMap<AST::Id, p::StringView> moduleFolders;
-		moduleFolders.Reserve(modules.Size());
+		TMap<Tag, AST::Id> modulesByFolder;
+		modulesByFolder.Reserve(modules.Size());
 		for (AST::Id moduleId : modules)
 		{
-			auto& file               = access.Get<const AST::CFileRef>(moduleId);
-			p::StringView folderPath = p::GetParentPath(file.path);
-			folders.InsertDefaulted(p::Tag{folderPath});
-			moduleFolders.Insert(moduleId, folderPath);
+			auto& file = access.Get<const AST::CFileRef>(moduleId);
+			const Tag folderName{p::GetParentPath(file.path)};
+			folders.InsertDefaulted(folderName);
+			modulesByFolder.Insert(folderName, moduleId);
 		}
 
 		// Create folders between modules
-		for (AST::Id oneId : modules)
+		for (AST::Id moduleId : modules)
 		{
-			bool insideOther         = false;
-			const p::StringView path = moduleFolders[oneId];
+			auto& file               = access.Get<const AST::CFileRef>(moduleId);
+			const p::StringView path = p::GetParentPath(file.path);
 
-			for (AST::Id otherId : modules)
+			// Check parent folders instead of comparing with every other module
+			bool insideOther         = false;
+			p::StringView parentPath = p::GetParentPath(path);
+			while (!parentPath.empty())
 			{
-				if (oneId != otherId
-				    && Strings::StartsWith(path, moduleFolders[otherId]))    // Is relative
+				if (modulesByFolder.Find(Tag{parentPath}))
 				{
 					insideOther = true;
 					break;
 				}
+				parentPath = p::GetParentPath(parentPath);
 			}
 
 			if (insideOther)
 			{
 				// If a module is inside another, create the folders in between
-				InsertItem(Item{.id = oneId, .path = p::String{path}, .isFolder = true});
+				InsertItem(Item{.id = moduleId, .path = p::String{path}, .isFolder = true});
 			}
 			else
 			{
 				// Add at root folder
-				folders[{}].items.Add(Item{.id = oneId, .path = p::String{path}, .isFolder = true});
+				folders[{}].items.Add(
+				    Item{.id = moduleId, .path = p::String{path}, .isFolder = true});
 			}
 		}
 
@@ -274,6 +361,64 @@ namespace rift::Editor
 				InsertItem(Item{typeId, file.path});
 			}
 		}
+
+		for (Tag folderName : openFolders)
+		{
+			if (Folder* folder = folders.Find(folderName))
+			{
+				folder->open = true;
+			}
+		}
+		if (firstBuild && !IsNone(projectModuleId))
+		{
+			const auto& file = access.Get<const AST::CFileRef>(projectModuleId);
+			if (Folder* folder = folders.Find(Tag{p::GetParentPath(file.path)}))
+			{
+				folder->open = true;
+			}
+		}
+	}
+
+	void FileExplorerPanel::UpdateProjectFiles(
+	    TAccessRef<AST::CProject, AST::CModule, AST::CFileRef, AST::CDeclType> access)
+	{
+		if (pendingTypeIds.IsEmpty())
+		{
+			return;
+		}
+
+		ZoneScoped;
+		for (AST::Id id : pendingTypeIds)
+		{
+			RemoveType(id);
+			if (access.IsValid(id) && access.Has<AST::CDeclType>(id)
+			    && access.Has<AST::CFileRef>(id))
+			{
+				auto& file = access.Get<const AST::CFileRef>(id);
+				if (!file.path.empty())
+				{
+					InsertItem(Item{id, file.path});
+				}
+			}
+		}
+		pendingTypeIds.Clear(false);
+		rowsDirty = true;
+	}
+
+	void FileExplorerPanel::OnTypesChanged(p::TView<const AST::Id> ids)
+	{
+		pendingTypeIds.Append(ids);
+	}
+
+	void FileExplorerPanel::OnModulesChanged()
+	{
+		dirty = true;
+	}
+
+	void FileExplorerPanel::RemapIds(const AST::IdRemap& remap)
+	{
+		renameId = remap.Get(renameId);
+		dirty    = true;
 	}
 
 	void FileExplorerPanel::SortFolder(Folder& folder)
@@ -286,21 +431,61 @@ namespace rift::Editor
 			}
 			return one.path < other.path;
 		});
+		folder.sorted = true;
+	}
+
+	void FileExplorerPanel::CacheRows()
+	{
+		ZoneScoped;
+		rowsDirty = false;
+		rows.Clear(false);
+		if (Folder* root = folders.Find({}))
+		{
+			AddFolderRows(*root, 0);
+		}
+	}
+
+	void FileExplorerPanel::AddFolderRows(Folder& folder, i32 depth)
+	{
+		if (!folder.sorted)
+		{
+			SortFolder(folder);
+		}
+		for (const Item& item : folder.items)
+		{
+			Folder* childFolder = item.isFolder ? folders.Find(Tag{item.path}) : nullptr;
+			rows.Add({&item, childFolder, depth});
+			if (childFolder && childFolder->open)
+			{
+				AddFolderRows(*childFolder, depth + 1);
+			}
+		}
 	}
 
-	void FileExplorerPanel::DrawItem(AST::Tree& ast, const Item& item)
+	void FileExplorerPanel::DrawItem(AST::Tree& ast, const Row& row)
 	{
+		const Item& item          = *row.item;
 		const String path         = p::ToString(item.path);
 		const StringView fileName = p::GetFilename(path);
 
-		if (Folder* folder = folders.Find(p::Tag{item.path}))
+		// Rows are drawn flat. Depth is shown by indenting them
+		const float indent = row.depth * UI::GetStyle().IndentSpacing;
+		if (indent > 0.f)
+		{
+			UI::Indent(indent);
+		}
+		UI::PushID(path.c_str());
+
+		if (Folder* folder = row.folder)
 		{
-			ImGuiTreeNodeFlags flags = 0;
+			ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_NoTreePushOnOpen;
 			if (folder->items.IsEmpty())
 			{
 				flags |= ImGuiTreeNodeFlags_Bullet;
 			}
+			UI::SetNextItemOpen(folder->open);
 
+			bool open;
 			auto* module = item.id != AST::NoId ? ast.TryGet<AST::CModule>(item.id) : nullptr;
 			if (module)
 			{
@@ -309,12 +494,7 @@ namespace rift::Editor
 
 				UI::PushHeaderColor(UI::primaryColor);
 				UI::PushStyleCompact();
-				const bool isProject = item.id == projectModuleId;
-				if (item.id == projectModuleId)    // Is project
-				{
-					flags |= ImGuiTreeNodeFlags_DefaultOpen;
-				}
-				bool open = UI::CollapsingHeader(text.data(), flags);
+				open = UI::TreeNodeEx(text.data(), flags | ImGuiTreeNodeFlags_CollapsingHeader);
 				UI::PopStyleCompact();
 				UI::PopHeaderColor();
 
@@ -328,38 +508,23 @@ namespace rift::Editor
 				{
 					OpenModuleEditor(ast, item.id);
 				}
-
-				if (open)
-				{
-					UI::TreePush(text.data());
-
-					SortFolder(*folder);
-					for (const auto& childItem : folder->items)
-					{
-						DrawItem(ast, childItem);
-					}
-					UI::TreePop();
-				}
 				DrawModuleActions(item.id, *module);
 			}
 			else    // Just a folder
 			{
 				const String text = Strings::Format(ICON_FA_FOLDER " {}", fileName);
-				bool open         = UI::TreeNodeEx(text.data(), flags);
+				open              = UI::TreeNodeEx(text.data(), flags);
 				if (UI::BeginPopupContextItem())
 				{
 					DrawContextMenu(ast, path, item.id);
 					UI::EndPopup();
 				}
-				if (open)
-				{
-					SortFolder(*folder);
-					for (const auto& childItem : folder->items)
-					{
-						DrawItem(ast, childItem);
-					}
-					UI::TreePop();
-				}
+			}
+
+			if (open != folder->open)
+			{
+				folder->open = open;
+				rowsDirty    = true;
 			}
 		}
 		else
@@ -423,6 +588,7 @@ namespace rift::Editor
 						if (auto* file = ast.TryGet<AST::CFileRef>(item.id))
 						{
 							file->path = destination;
+							pendingTypeIds.Add(item.id);
 						}
 
 						auto& types = ast.GetOrSetStatic<AST::STypes>();
@@ -467,6 +633,12 @@ namespace rift::Editor
 				UI::NewLine();
 			}
 		}
+
+		UI::PopID();
+		if (indent > 0.f)
+		{
+			UI::Unindent(indent);
+		}
 	}
 
 	void FileExplorerPanel::DrawModuleActions(AST::Id id, AST::CModule& module) {}
@@ -3,6 +3,7 @@
 #include "Systems/EditorSystem.h"
 
 #include "AST/Utils/ModuleUtils.h"
+#include "AST/Utils/TransactionUtils.h"
 #include "AST/Utils/TypeUtils.h"
 #include "Components/CModuleEditor.h"
 #include "Components/CTypeEditor.h"
@@ -23,7 +24,9 @@
 #include <AST/Components/CFileRef.h>
 #include <AST/Components/CModule.h>
 #include <AST/Components/Tags/CDirty.h>
+#include <AST/Utils/SystemScheduler.h>
 #include <Compiler/Compiler.h>
+#include <GLFW/glfw3.h>
 #include <IconsFontAwesome5.h>
 #include <LLVMBackendModule.h>
 #include <Pipe/Files/FileDialog.h>
@@ -92,12 +95,40 @@ namespace rift::Editor::EditorSystem
 	void Init(AST::Tree& ast)
 	{
 		OnProjectEditorOpen(ast);
+		BindHooks(ast);
+	}
+
+	void BindHooks(AST::Tree& ast)
+	{
 		ast.OnAdd<CTypeEditor>().Bind([](auto& ast, auto ids) {
 			for (AST::Id id : ids)
 			{
 				OnTypeEditorOpen(static_cast<AST::Tree&>(ast), id);
 			}
 		});
+
+		// Keep the file explorer updated from file, type and module changes
+		auto onTypesChanged = [](auto& ast, auto ids) {
+			if (auto* editor = ast.template TryGetStatic<SEditor>())
+			{
+				editor->fileExplorer.OnTypesChanged(ids);
+			}
+		};
+		auto onModulesChanged = [](auto& ast, auto ids) {
+			if (auto* editor = ast.template TryGetStatic<SEditor>())
+			{
+				editor->fileExplorer.OnModulesChanged();
+			}
+		};
+		ast.OnAdd<AST::CFileRef>().Bind(onTypesChanged);
+		ast.OnRemove<AST::CFileRef>().Bind(onTypesChanged);
+		ast.OnAdd<AST::CDeclType>().Bind(onTypesChanged);
+		ast.OnRemove<AST::CDeclType>().Bind(onTypesChanged);
+		ast.OnAdd<AST::CModule>().Bind(onModulesChanged);
+		ast.OnRemove<AST::CModule>().Bind(onModulesChanged);
+		AST::RegisterHookWrites<AST::CFileRef, SEditor>();
+		AST::RegisterHookWrites<AST::CDeclType, SEditor>();
+		AST::RegisterHookWrites<AST::CModule, SEditor>();
 	}
 
 	// Root Editor
@@ -153,6 +184,7 @@ namespace rift::Editor::EditorSystem
 		}
 #endif
 
+		Editor::Get().GetProfiler().Draw();
 		UI::DrawNotifications();
 	}
 
@@ -234,6 +266,19 @@ namespace rift::Editor::EditorSystem
 
 		DrawProjectMenuBar(ast, editor);
 
+		const ImGuiIO& io = ImGui::GetIO();
+		if (io.KeyCtrl && !io.WantTextInput)
+		{
+			if (UI::IsKeyPressed(GLFW_KEY_Z, false))
+			{
+				AST::Transactions::Undo(ast);
+			}
+			else if (UI::IsKeyPressed(GLFW_KEY_Y, false))
+			{
+				AST::Transactions::Redo(ast);
+			}
+		}
+
 		if (editor.skipFrameAfterMenu)    // We could have closed the project
 		{
 			editor.skipFrameAfterMenu = false;
@@ -243,13 +288,25 @@ namespace rift::Editor::EditorSystem
 
 		CreateRootDockspace(editor);
 
-		DrawModuleEditors(ast, editor);
-		DrawTypes(ast, editor);
-
-		editor.reflectionDebugger.Draw();
-		editor.astDebugger.Draw(ast);
-		editor.memoryDebugger.Draw();
-		editor.fileExplorer.Draw(ast);
+		FrameProfiler& profiler = Editor::Get().GetProfiler();
+		{
+			FrameProfiler::Scope scope{profiler, "Module Editors"};
+			DrawModuleEditors(ast, editor);
+		}
+		{
+			FrameProfiler::Scope scope{profiler, "Type Editors"};
+			DrawTypes(ast, editor);
+		}
+		{
+			FrameProfiler::Scope scope{profiler, "Debuggers"};
+			editor.reflectionDebugger.Draw();
+			editor.astDebugger.Draw(ast);
+			editor.memoryDebugger.Draw();
+		}
+		{
+			FrameProfiler::Scope scope{profiler, "File Explorer"};
+			editor.fileExplorer.Draw(ast);
+		}
 		editor.graphPlayground.Draw(ast, editor.layout);
 
 		UI::PopID();
@@ -272,6 +329,7 @@ namespace rift::Editor::EditorSystem
 				}
 				if (UI::MenuItem("Close current"))
 				{
+					Editor::Get().GetBuildService().Cancel();
 					AST::CloseProject(ast);
 					editorData.skipFrameAfterMenu = true;
 				}
@@ -318,25 +376,34 @@ namespace rift::Editor::EditorSystem
 
 			if (UI::BeginMenu("Build"))
 			{
+				auto& buildService = Editor::Get().GetBuildService();
 				if (UI::MenuItem("Build current"))
 				{
-					AST::Tree compileAST{ast};    // Intentional copy
-					CompilerConfig config;
-					Build<LLVMBackend>(compileAST, config);
+					buildService.Start(ast, LLVMBackend::GetStaticType());
 				}
 				if (UI::MenuItem("Build all"))
 				{
-					AST::Tree compileAST{ast};    // Intentional copy
-					CompilerConfig config;
-					Build<LLVMBackend>(compileAST, config);
+					buildService.Start(ast, LLVMBackend::GetStaticType());
 				}
+				UI::Separator();
+				if (UI::MenuItem("Cancel build", nullptr, false, buildService.IsBuilding()))
+				{
+					buildService.Cancel();
+				}
+				UI::MenuItem("Restart build on edit", nullptr, &buildService.restartOnEdit);
 				UI::EndMenu();
 			}
 
 			if (UI::BeginMenu("Edit"))
 			{
-				if (UI::MenuItem("Undo", "CTRL+Z")) {}
-				if (UI::MenuItem("Redo", "CTRL+Y", false, false)) {}    // Disabled item
+				if (UI::MenuItem("Undo", "CTRL+Z", false, AST::Transactions::CanUndo(ast)))
+				{
+					AST::Transactions::Undo(ast);
+				}
+				if (UI::MenuItem("Redo", "CTRL+Y", false, AST::Transactions::CanRedo(ast)))
+				{
+					AST::Transactions::Redo(ast);
+				}
 				UI::Separator();
 				if (UI::MenuItem("Cut", "CTRL+X")) {}
 				if (UI::MenuItem("Copy", "CTRL+C")) {}
@@ -363,7 +430,13 @@ namespace rift::Editor::EditorSystem
 					UI::MenuItem("Reflection", nullptr, &editorData.reflectionDebugger.open);
 					UI::MenuItem("Abstract Syntax Tree", nullptr, &editorData.astDebugger.open);
 					UI::MenuItem("Memory", nullptr, &editorData.memoryDebugger.open);
+					UI::MenuItem("Frame Profiler", nullptr, &Editor::Get().GetProfiler().open);
 					UI::MenuItem("Graph Playground", nullptr, &editorData.graphPlayground.open);
+					UI::Separator();
+					if (UI::MenuItem("Compact project"))
+					{
+						Editor::Get().RequestCompaction();
+					}
 					UI::EndMenu();
 				}
 				UI::EndMenu();
@@ -383,6 +456,13 @@ namespace rift::Editor::EditorSystem
 				}
 				UI::EndMenu();
 			}
+
+			auto& buildService = Editor::Get().GetBuildService();
+			if (buildService.IsBuilding())
+			{
+				UI::Separator();
+				UI::Text(Strings::Format("Building: {}", buildService.GetStage()));
+			}
 			UI::EndMainMenuBar();
 		}
 	}
@@ -2,12 +2,20 @@
 
 #include "Tools/ASTDebugger.h"
 
+#include "Editor.h"
+
+#include <AST/Components/CExprInputs.h>
+#include <AST/Components/CExprOutputs.h>
 #include <AST/Components/CStmtOutputs.h>
 #include <AST/Statics/STypes.h>
 #include <AST/Tree.h>
+#include <AST/Utils/Compaction.h>
+#include <AST/Utils/MemoryStats.h>
 #include <AST/Utils/Namespaces.h>
 #include <AST/Utils/Paths.h>
+#include <AST/Utils/PoolVersions.h>
 #include <IconsFontAwesome5.h>
+#include <Pipe/Core/Profiler.h>
 #include <Pipe/Reflect/TypeRegistry.h>
 #include <UI/Inspection.h>
 #include <UI/UI.h>
@@ -17,6 +25,46 @@ namespace rift::Editor
 {
 	using namespace p::core;
 
+	void DrawIds(p::StringView label, p::TView<const AST::Id> ids)
+	{
+		static p::String text;
+		text.clear();
+		p::Strings::FormatTo(text, "{}:", label);
+		for (AST::Id id : ids)
+		{
+			p::Strings::FormatTo(text, " {}", id);
+		}
+		UI::Text(text);
+	}
+
+	// Pin lists are small arrays, which are not reflected. They are drawn here instead
+	void DrawPinLists(AST::Tree& ast, AST::Id entityId, p::TypeId typeId)
+	{
+		if (typeId == p::GetTypeId<AST::CExprInputs>())
+		{
+			const auto& inputs = ast.Get<const AST::CExprInputs>(entityId);
+			DrawIds("pinIds", inputs.pinIds);
+			static p::String text;
+			text.clear();
+			text.append("linkedOutputs:");
+			for (const AST::ExprOutput& output : inputs.linkedOutputs)
+			{
+				p::Strings::FormatTo(text, " {}:{}", output.nodeId, output.pinId);
+			}
+			UI::Text(text);
+		}
+		else if (typeId == p::GetTypeId<AST::CExprOutputs>())
+		{
+			DrawIds("pinIds", ast.Get<const AST::CExprOutputs>(entityId).pinIds);
+		}
+		else if (typeId == p::GetTypeId<AST::CStmtOutputs>())
+		{
+			const auto& outputs = ast.Get<const AST::CStmtOutputs>(entityId);
+			DrawIds("pinIds", outputs.pinIds);
+			DrawIds("linkInputNodes", outputs.linkInputNodes);
+		}
+	}
+
 	void DrawEntityInspector(AST::Tree& ast, AST::Id entityId, bool* open = nullptr)
 	{
 		p::String name = "Entity Inspector";
@@ -57,6 +105,7 @@ namespace rift::Editor
 					UI::InspectProperties(data, dataType);
 					UI::EndInspector();
 				}
+				DrawPinLists(ast, entityId, poolInstance.componentId);
 				UI::Unindent();
 			}
 		}
@@ -105,6 +154,75 @@ namespace rift::Editor
 	}
 
 
+	void DrawMemoryDebug(AST::Tree& ast)
+	{
+		if (!UI::CollapsingHeader("Memory"))
+		{
+			return;
+		}
+
+		const AST::TreeMemoryStats stats = AST::GetMemoryStats(ast);
+		UI::Text(p::Strings::Format("Pools: ~{}  Statics: ~{}",
+		    p::Strings::ParseMemorySize(stats.GetPoolBytes()),
+		    p::Strings::ParseMemorySize(stats.GetStaticBytes())));
+		UI::Text(p::Strings::Format("Namespaces: {} ({})", stats.namespaceCount,
+		    p::Strings::ParseMemorySize(stats.namespaceBytes)));
+		UI::Text(p::Strings::Format("Tags: {} (~{})", stats.tagCount,
+		    p::Strings::ParseMemorySize(stats.tagBytes)));
+		if (UI::Button("Copy as JSON"))
+		{
+			UI::SetClipboardText(AST::MemoryStatsToJson(stats).c_str());
+		}
+		UI::SameLine();
+		if (UI::Button("Compact project"))
+		{
+			Editor::Get().RequestCompaction();
+		}
+
+		static const ImGuiTableFlags flags = ImGuiTableFlags_Resizable | ImGuiTableFlags_Hideable
+		                                   | ImGuiTableFlags_SizingStretchProp
+		                                   | ImGuiTableFlags_RowBg;
+		UI::BeginChild("memoryTableChild",
+		    ImVec2(0.f, p::math::Min(250.f, UI::GetContentRegionAvail().y - 20.f)));
+		if (UI::BeginTable("memoryTable", 4, flags))
+		{
+			UI::TableSetupColumn("Name", ImGuiTableColumnFlags_WidthStretch, 2.f);
+			UI::TableSetupColumn("Count");
+			UI::TableSetupColumn("Inline");
+			UI::TableSetupColumn("Heap (approx.)");
+			UI::TableHeadersRow();
+
+			static p::String text;
+			for (const AST::PoolMemoryStats& pool : stats.pools)
+			{
+				UI::TableNextRow();
+				UI::TableNextColumn();
+				UI::Text(pool.name);
+				UI::TableNextColumn();
+				text.clear();
+				p::Strings::FormatTo(text, "{}", pool.count);
+				UI::Text(text);
+				UI::TableNextColumn();
+				UI::Text(p::Strings::ParseMemorySize(pool.inlineBytes));
+				UI::TableNextColumn();
+				UI::Text(pool.registered ? p::Strings::ParseMemorySize(pool.heapBytes) : "?");
+			}
+			for (const AST::StaticMemoryStats& value : stats.statics)
+			{
+				UI::TableNextRow();
+				UI::TableNextColumn();
+				UI::Text(value.name);
+				UI::TableNextColumn();
+				UI::TableNextColumn();
+				UI::Text(p::Strings::ParseMemorySize(value.bytes));
+				UI::TableNextColumn();
+			}
+			UI::EndTable();
+		}
+		UI::EndChild();
+	}
+
+
 	ASTDebugger::ASTDebugger() {}
 
 	void ASTDebugger::Draw(AST::Tree& ast)
@@ -117,12 +235,20 @@ namespace rift::Editor
 		UI::Begin("Abstract Syntax Tree", &open);
 
 		DrawTypesDebug(ast);
+		DrawMemoryDebug(ast);
 
 		if (UI::CollapsingHeader("Nodes"))
 		{
 			if (ImGui::BeginPopup("Options"))
 			{
-				ImGui::Checkbox("Show hierarchy", &showHierarchy);
+				if (ImGui::Checkbox("Show hierarchy", &showHierarchy))
+				{
+					rowsDirty = true;
+				}
+				if (UI::MenuItem("Refresh"))
+				{
+					rowsDirty = true;
+				}
 				ImGui::EndPopup();
 			}
 
@@ -131,7 +257,20 @@ namespace rift::Editor
 				UI::OpenPopup("Options");
 			}
 			UI::SameLine();
-			filter.Draw("##Filter", -100.0f);
+			if (filter.Draw("##Filter", -100.0f))
+			{
+				rowsDirty = true;
+			}
+
+			// Entities without any of these components are only found on refresh
+			const p::u64 version =
+			    AST::GetPoolVersion<AST::CNamespace>(ast) + AST::GetPoolVersion<AST::CFileRef>(ast)
+			    + AST::GetPoolVersion<AST::CParent>(ast) + AST::GetPoolVersion<AST::CChild>(ast);
+			if (rowsDirty || version != rowsVersion)
+			{
+				rowsVersion = version;
+				CacheRows(ast);
+			}
 
 
 			static ImGuiTableFlags flags = ImGuiTableFlags_Reorderable | ImGuiTableFlags_Resizable
@@ -153,42 +292,93 @@ namespace rift::Editor
 				UI::TableHeadersRow();
 
 				DrawNodeAccess access{ast};
-				if (showHierarchy && !filter.IsActive())
+				// Only visible rows are drawn
+				ImGuiListClipper clipper;
+				clipper.Begin(rows.Size());
+				while (clipper.Step())
 				{
-					p::TArray<AST::Id> roots;
-					p::GetRoots(access, roots);
-					for (auto root : roots)
+					for (p::i32 i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
 					{
-						DrawNode(access, root, true);
-					}
-
-					p::TArray<AST::Id> orphans = p::FindAllIdsWith<AST::CNamespace>(access);
-					p::ExcludeIdsWith<AST::CChild>(access, orphans);
-					p::ExcludeIdsWith<AST::CParent>(access, orphans);
-					for (auto orphan : orphans)
-					{
-						DrawNode(access, orphan, true);
+						DrawNode(access, rows[i]);
 					}
 				}
-				else
-				{
-					ast.Each([this, &access](AST::Id id) {
-						DrawNode(access, id, false);
-					});
-				}
 				UI::EndTable();
 			}
 			UI::EndChild();
-			UI::Separator();
+			UI::Text(p::Strings::Format("{} nodes", rows.Size()));
 		}
 		UI::End();
 
 		DrawEntityInspector(ast, selectedNode, &open);
 	}
 
-	void ASTDebugger::DrawNode(DrawNodeAccess access, AST::Id nodeId, bool showChildren)
+	void ASTDebugger::RemapIds(const AST::IdRemap& remap)
+	{
+		selectedNode = remap.Get(selectedNode);
+		AST::RemapStaticIds(expandedIds, remap);
+		expandedIds.RemoveIf([](AST::Id id) {
+			return AST::IsNone(id);
+		});
+		// Pool versions restart on the compacted tree
+		rowsDirty = true;
+	}
+
+	void ASTDebugger::CacheRows(AST::Tree& ast)
+	{
+		ZoneScoped;
+		rowsDirty = false;
+		rows.Clear(false);
+
+		DrawNodeAccess access{ast};
+		if (showHierarchy && !filter.IsActive())
+		{
+			p::TArray<AST::Id> roots;
+			p::GetRoots(access, roots);
+			for (AST::Id root : roots)
+			{
+				AddNodeRows(access, root, 0);
+			}
+
+			p::TArray<AST::Id> orphans = p::FindAllIdsWith<AST::CNamespace>(access);
+			p::ExcludeIdsWith<AST::CChild>(access, orphans);
+			p::ExcludeIdsWith<AST::CParent>(access, orphans);
+			for (AST::Id orphan : orphans)
+			{
+				AddNodeRows(access, orphan, 0);
+			}
+		}
+		else
+		{
+			ast.Each([this, &access](AST::Id id) {
+				if (PassFilter(access, id))
+				{
+					rows.Add({id, 0, false});
+				}
+			});
+		}
+
+		// Forget expanded nodes that were destroyed
+		expandedIds.RemoveIf([&ast](AST::Id id) {
+			return !ast.IsValid(id);
+		});
+	}
+
+	void ASTDebugger::AddNodeRows(DrawNodeAccess access, AST::Id nodeId, p::i32 depth)
+	{
+		const auto* parent     = access.TryGet<const AST::CParent>(nodeId);
+		const bool hasChildren = parent && !parent->children.IsEmpty();
+		rows.Add({nodeId, depth, hasChildren});
+		if (hasChildren && expandedIds.Contains(nodeId))
+		{
+			for (AST::Id child : parent->children)
+			{
+				AddNodeRows(access, child, depth + 1);
+			}
+		}
+	}
+
+	void FormatIdText(p::String& idText, AST::Id nodeId)
 	{
-		static p::String idText;
 		idText.clear();
 		if (nodeId == AST::NoId)
 		{
@@ -202,30 +392,48 @@ namespace rift::Editor
 		{
 			p::Strings::FormatTo(idText, "{}", p::GetIdIndex(nodeId));
 		}
+	}
 
-		static p::String name;
+	template<typename AccessType>
+	void FormatNameText(AccessType access, p::String& name, p::String& path, AST::Id nodeId)
+	{
 		name.clear();
-		if (const auto* id = access.TryGet<const AST::CNamespace>(nodeId))
+		if (const auto* id = access.template TryGet<const AST::CNamespace>(nodeId))
 		{
 			name = id->name.AsString();
 		}
 
-		static p::String path;
 		path.clear();
-		if (const auto* file = access.TryGet<const AST::CFileRef>(nodeId))
+		if (const auto* file = access.template TryGet<const AST::CFileRef>(nodeId))
 		{
 			path = p::ToString(file->path);
 
 			p::StringView filename = p::GetFilename(path);
 			p::Strings::FormatTo(name, name.empty() ? "file: {}" : " (file: {})", filename);
 		}
+	}
 
-		if (!filter.PassFilter(idText.c_str(), idText.c_str() + idText.size())
-		    && !filter.PassFilter(name.c_str(), name.c_str() + name.size()))
+	bool ASTDebugger::PassFilter(DrawNodeAccess access, AST::Id nodeId) const
+	{
+		if (!filter.IsActive())
 		{
-			return;
+			return true;
 		}
 
+		static p::String idText, name, path;
+		FormatIdText(idText, nodeId);
+		FormatNameText(access, name, path, nodeId);
+		return filter.PassFilter(idText.c_str(), idText.c_str() + idText.size())
+		    || filter.PassFilter(name.c_str(), name.c_str() + name.size());
+	}
+
+	void ASTDebugger::DrawNode(DrawNodeAccess access, const Row& row)
+	{
+		const AST::Id nodeId = row.id;
+		static p::String idText, name, path;
+		FormatIdText(idText, nodeId);
+		FormatNameText(access, name, path, nodeId);
+
 		ImGui::TableNextRow();
 		ImGui::TableNextColumn();
 		static p::String inspectLabel;
@@ -243,24 +451,33 @@ namespace rift::Editor
 
 
 		ImGui::TableNextColumn();
-		bool hasChildren;
-		const AST::CParent* parent = nullptr;
-		if (showChildren)
-		{
-			parent      = access.TryGet<const AST::CParent>(nodeId);
-			hasChildren = parent && !parent->children.IsEmpty();
-		}
-		else
+		// Rows are drawn flat. Depth is shown by indenting them
+		const float indent = row.depth * UI::GetStyle().IndentSpacing;
+		if (indent > 0.f)
 		{
-			hasChildren = false;
+			UI::Indent(indent);
 		}
-
-		bool open = false;
 		static Tag font{"WorkSans"};
 		UI::PushFont(font, UI::FontMode::Bold);
-		if (hasChildren)
+		if (row.hasChildren)
 		{
-			open = UI::TreeNodeEx(idText.c_str(), ImGuiTreeNodeFlags_SpanFullWidth);
+			const bool expanded = expandedIds.Contains(nodeId);
+			UI::SetNextItemOpen(expanded);
+			const bool open = UI::TreeNodeEx(idText.c_str(),
+			    ImGuiTreeNodeFlags_SpanFullWidth | ImGuiTreeNodeFlags_NoTreePushOnOpen);
+			if (open != expanded)
+			{
+				if (open)
+				{
+					expandedIds.Add(nodeId);
+				}
+				else
+				{
+					expandedIds.Remove(nodeId, false);
+				}
+				// Rows are not modified while they are being drawn
+				rowsDirty = true;
+			}
 		}
 		else
 		{
@@ -269,6 +486,10 @@ namespace rift::Editor
 			UI::Unindent(10.f);
 		}
 		UI::PopFont();
+		if (indent > 0.f)
+		{
+			UI::Unindent(indent);
+		}
 
 
 		ImGui::TableNextColumn();
@@ -284,18 +505,7 @@ namespace rift::Editor
 
 		if (ImGui::TableNextColumn())
 		{
-			UI::Text(AST::GetParentNamespace(access, nodeId).ToString());
-		}
-
-
-		if (hasChildren && open)
-		{
-			for (AST::Id child : parent->children)
-			{
-				DrawNode(access, child, true);
-			}
-
-			UI::TreePop();
+			UI::Text(AST::GetFullName(access, p::GetParent(access, nodeId)).AsString());
 		}
 	}
 }    // namespace rift::Editor
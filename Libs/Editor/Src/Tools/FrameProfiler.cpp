@@ -0,0 +1,163 @@
+// Copyright 2015-2023 Piperift - All rights reserved
+
+#include "Tools/FrameProfiler.h"
+
+#include <Pipe/Math/Math.h>
+#include <UI/UI.h>
+
+
+namespace rift::Editor
+{
+	FrameProfiler::Scope::Scope(FrameProfiler& profiler, StringView name)
+	    : profiler{profiler}, stepIndex{profiler.BeginStep(name)}, start{Clock::now()}
+	{}
+
+	FrameProfiler::Scope::~Scope()
+	{
+		profiler.EndStep(
+		    stepIndex, std::chrono::duration<float, std::milli>(Clock::now() - start).count());
+	}
+
+
+	void FrameProfiler::BeginFrame()
+	{
+		depth         = 0;
+		lastStepIndex = NO_INDEX;
+		if (paused)
+		{
+			return;
+		}
+
+		historyIndex = (historyIndex + 1) % historySize;
+		for (Step& step : steps)
+		{
+			step.history[historyIndex] = 0.f;
+		}
+	}
+
+	void FrameProfiler::Record(StringView name, float time)
+	{
+		EndStep(BeginStep(name), time);
+	}
+
+	void FrameProfiler::RecordSystems(const AST::SystemScheduler& scheduler)
+	{
+		const TView<const AST::SystemScheduler::System> systems = scheduler.GetSystems();
+		const TView<const float> times                          = scheduler.GetTimes();
+		for (i32 i = 0; i < systems.Size() && i < times.Size(); ++i)
+		{
+			Record(systems[i].name, times[i]);
+		}
+	}
+
+	void FrameProfiler::Draw()
+	{
+		if (!open)
+		{
+			return;
+		}
+
+		if (UI::Begin("Frame Profiler", &open))
+		{
+			UI::Checkbox("Paused", &paused);
+
+			static const ImGuiTableFlags flags = ImGuiTableFlags_Resizable | ImGuiTableFlags_RowBg
+			                                   | ImGuiTableFlags_SizingStretchProp;
+			if (UI::BeginTable("profilerTable", 5, flags))
+			{
+				UI::TableSetupColumn("Step", ImGuiTableColumnFlags_WidthStretch, 2.f);
+				UI::TableSetupColumn("Last");
+				UI::TableSetupColumn("Average");
+				UI::TableSetupColumn("Max");
+				UI::TableSetupColumn("History", ImGuiTableColumnFlags_WidthStretch, 2.f);
+				UI::TableHeadersRow();
+
+				static String text;
+				// The current frame is still being recorded. History is shown until the last one
+				float values[historySize - 1];
+				for (i32 stepIndex : order)
+				{
+					const Step& step = steps[stepIndex];
+					float average    = 0.f;
+					float max        = 0.f;
+					for (i32 i = 0; i < historySize - 1; ++i)
+					{
+						values[i] = step.history[(historyIndex + 1 + i) % historySize];
+						average += values[i];
+						max = math::Max(max, values[i]);
+					}
+					average /= historySize - 1;
+
+					UI::TableNextRow();
+					UI::TableNextColumn();
+					const float indent = step.depth * UI::GetStyle().IndentSpacing;
+					if (indent > 0.f)
+					{
+						UI::Indent(indent);
+					}
+					UI::Text(step.name);
+					if (indent > 0.f)
+					{
+						UI::Unindent(indent);
+					}
+
+					UI::TableNextColumn();
+					text.clear();
+					Strings::FormatTo(text, "{:.2f} ms", values[historySize - 2]);
+					UI::Text(text);
+					UI::TableNextColumn();
+					text.clear();
+					Strings::FormatTo(text, "{:.2f} ms", average);
+					UI::Text(text);
+					UI::TableNextColumn();
+					text.clear();
+					Strings::FormatTo(text, "{:.2f} ms", max);
+					UI::Text(text);
+
+					UI::TableNextColumn();
+					UI::PushID(stepIndex);
+					UI::SetNextItemWidth(-FLT_MIN);
+					UI::PlotLines("##history", values, historySize - 1, 0, nullptr, 0.f, max,
+					    ImVec2(0.f, UI::GetTextLineHeight()));
+					UI::PopID();
+				}
+				UI::EndTable();
+			}
+		}
+		UI::End();
+	}
+
+	i32 FrameProfiler::BeginStep(StringView name)
+	{
+		if (paused)
+		{
+			return NO_INDEX;
+		}
+
+		i32 stepIndex = steps.FindIndex([name](const Step& step) {
+			return step.name == name;
+		});
+		if (stepIndex == NO_INDEX)
+		{
+			// New steps are shown after the step that started before them
+			stepIndex = steps.Size();
+			steps.Add({String{name}, depth});
+			order.Insert(order.FindIndex(lastStepIndex) + 1, stepIndex);
+		}
+		lastStepIndex = stepIndex;
+		++depth;
+		return stepIndex;
+	}
+
+	void FrameProfiler::EndStep(i32 stepIndex, float time)
+	{
+		if (stepIndex == NO_INDEX)
+		{
+			return;
+		}
+
+		// Steps can run more than once per frame
+		steps[stepIndex].history[historyIndex] += time;
+		--depth;
+	}
+}    // namespace rift::Editor
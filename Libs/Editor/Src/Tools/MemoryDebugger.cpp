@@ -20,6 +20,14 @@ namespace rift::Editor
 	static constexpr Color gUsedColor{56, 210, 41};    // Green
 
 
+	void FormatAllocation(String& label, const MemoryDebugger::Allocation& allocation)
+	{
+		label.clear();
+		Strings::FormatTo(
+		    label, "{}  ({})", allocation.ptr, Strings::ParseMemorySize(allocation.size));
+	}
+
+
 	MemoryDebugger::MemoryDebugger() {}
 
 	void MemoryDebugger::Draw()
@@ -31,45 +39,130 @@ namespace rift::Editor
 
 		if (UI::Begin("Memory", &open))
 		{
-			String label;
+			static String label;
 			auto* stats = GetHeapStats();
-			UI::Text(Strings::Format("Used: {}", Strings::ParseMemorySize(stats->used)));
+			UI::Text(Strings::Format("Used: {}  Allocations: {}",
+			    Strings::ParseMemorySize(stats->used), stats->allocations.Size()));
 
-			if (UI::BeginChild("Allocations"))
+			if (UI::Button("Refresh"))
 			{
-				const i32 shown = math::Min<i32>(10000, i32(stats->allocations.Size()));
-				for (i32 i = 0; i < shown; ++i)
+				filterDirty = true;
+			}
+			UI::SameLine();
+			if (filter.Draw("##Filter", -100.0f))
+			{
+				filterDirty = true;
+			}
+
+			const bool filtering = filter.IsActive();
+			if (filtering && filterDirty)
+			{
+				filterDirty = false;
+				filtered.Clear(false);
+				// Reserve first. Allocating while iterating would modify the allocations
+				filtered.Reserve(i32(stats->allocations.Size()));
+				for (i32 i = 0; i < i32(stats->allocations.Size()); ++i)
 				{
-					const auto& allocation = stats->allocations[i];
-					label.clear();
-					Strings::FormatTo(label, "{}", allocation.ptr);
-					if (UI::TreeNodeEx(label.c_str()))
+					const Allocation allocation{
+					    stats->allocations[i].ptr, stats->allocations[i].size};
+					FormatAllocation(label, allocation);
+					if (filter.PassFilter(label.c_str(), label.c_str() + label.size()))
 					{
-						label.clear();
-						Strings::FormatTo(label, "Address: {}, Size: {}", allocation.ptr,
-						    Strings::ParseMemorySize(allocation.size));
-						UI::Text(label.c_str());
+						filtered.Add(allocation);
+					}
+				}
+			}
 
-#if PIPE_ENABLE_ALLOCATION_STACKS
-						UI::Text("Stack trace:");
-						const auto& stack = stats->allocationStacks[i];
-						backward::TraceResolver tr;
-						tr.load_stacktrace(stack);
-						for (sizet i = 0; i < stack.size(); ++i)
+			const float detailsHeight = selectedPtr ? 200.f : 0.f;
+			if (UI::BeginChild("Allocations", ImVec2(0.f, -detailsHeight)))
+			{
+				const i32 count = filtering ? filtered.Size() : i32(stats->allocations.Size());
+				// Only visible rows are formatted and drawn
+				ImGuiListClipper clipper;
+				clipper.Begin(count);
+				while (clipper.Step())
+				{
+					for (i32 i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
+					{
+						Allocation allocation;
+						if (filtering)
 						{
-							backward::ResolvedTrace trace = tr.resolve(stack[i]);
-							label.clear();
-							Strings::FormatTo(label, "#{} {} {} [{}]", i, trace.object_filename,
-							    trace.object_function, trace.addr);
-							UI::Text(label);
+							allocation = filtered[i];
 						}
-#endif
-						UI::TreePop();
+						else if (i < i32(stats->allocations.Size()))
+						{
+							allocation = {stats->allocations[i].ptr, stats->allocations[i].size};
+						}
+						else    // Freed while drawing
+						{
+							break;
+						}
+
+						FormatAllocation(label, allocation);
+						UI::PushID(i);
+						if (UI::Selectable(label.c_str(), allocation.ptr == selectedPtr))
+						{
+							Select(allocation);
+						}
+						UI::PopID();
 					}
 				}
 			}
 			UI::EndChild();
+
+			if (selectedPtr)
+			{
+				DrawDetails();
+			}
 		}
 		UI::End();
 	}
+
+	void MemoryDebugger::Select(const Allocation& allocation)
+	{
+		selectedPtr  = allocation.ptr;
+		selectedSize = allocation.size;
+		selectedStack.Clear();
+
+#if PIPE_ENABLE_ALLOCATION_STACKS
+		// Stacks are resolved once on selection. Resolving them is slow
+		auto* stats = GetHeapStats();
+		for (i32 i = 0; i < i32(stats->allocations.Size()); ++i)
+		{
+			if (stats->allocations[i].ptr != allocation.ptr)
+			{
+				continue;
+			}
+
+			const auto stack = stats->allocationStacks[i];
+			backward::TraceResolver tr;
+			tr.load_stacktrace(stack);
+			for (sizet j = 0; j < stack.size(); ++j)
+			{
+				backward::ResolvedTrace trace = tr.resolve(stack[j]);
+				Strings::FormatTo(selectedStack.AddRef(), "#{} {} {} [{}]", j,
+				    trace.object_filename, trace.object_function, trace.addr);
+			}
+			break;
+		}
+#endif
+	}
+
+	void MemoryDebugger::DrawDetails()
+	{
+		UI::Separator();
+		if (UI::BeginChild("Details"))
+		{
+			UI::Text(Strings::Format("Address: {}, Size: {}", selectedPtr,
+			    Strings::ParseMemorySize(selectedSize)));
+#if PIPE_ENABLE_ALLOCATION_STACKS
+			UI::Text("Stack trace:");
+			for (const String& line : selectedStack)
+			{
+				UI::Text(line);
+			}
+#endif
+		}
+		UI::EndChild();
+	}
 }    // namespace rift::Editor
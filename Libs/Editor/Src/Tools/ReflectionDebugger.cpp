@@ -23,19 +23,20 @@ namespace rift::Editor
 	{
 		if (!open)
 		{
+			// Types registered while closed are listed when opened again
+			rowsDirty = true;
 			return;
 		}
 
-		const auto& registry = TypeRegistry::Get();
-
 		UI::Begin("Reflection", &open);
 
 		if (UI::BeginPopup("Filter"))
 		{
-			UI::CheckboxFlags("Native", (u32*)&categoryFilter, u32(TypeCategory::Native));
-			UI::CheckboxFlags("Enum", (u32*)&categoryFilter, u32(TypeCategory::Enum));
-			UI::CheckboxFlags("Class", (u32*)&categoryFilter, u32(TypeCategory::Class));
-			UI::CheckboxFlags("Struct", (u32*)&categoryFilter, u32(TypeCategory::Struct));
+			u32* categories = (u32*)&categoryFilter;
+			rowsDirty |= UI::CheckboxFlags("Native", categories, u32(TypeCategory::Native));
+			rowsDirty |= UI::CheckboxFlags("Enum", categories, u32(TypeCategory::Enum));
+			rowsDirty |= UI::CheckboxFlags("Class", categories, u32(TypeCategory::Class));
+			rowsDirty |= UI::CheckboxFlags("Struct", categories, u32(TypeCategory::Struct));
 			UI::EndPopup();
 		}
 		if (UI::Button("Filter"))
@@ -44,7 +45,14 @@ namespace rift::Editor
 		}
 
 		UI::SameLine();
-		filter.Draw("##Filter", -100.0f);
+		if (filter.Draw("##Filter", -100.0f))
+		{
+			rowsDirty = true;
+		}
+		if (rowsDirty)
+		{
+			CacheRows();
+		}
 
 
 		static ImGuiTableFlags flags = ImGuiTableFlags_Reorderable | ImGuiTableFlags_Resizable
@@ -58,9 +66,14 @@ namespace rift::Editor
 			UI::TableSetupColumn("Parent");
 			UI::TableHeadersRow();
 
-			for (auto it : registry)
+			ImGuiListClipper clipper;
+			clipper.Begin(rows.Size());
+			while (clipper.Step())
 			{
-				DrawType(it.second);
+				for (i32 i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
+				{
+					DrawType(rows[i]);
+				}
 			}
 			UI::EndTable();
 		}
@@ -69,11 +82,28 @@ namespace rift::Editor
 		UI::End();
 	}
 
-	void ReflectionDebugger::DrawType(Type* type)
+	void ReflectionDebugger::CacheRows()
+	{
+		rowsDirty = false;
+		rows.Clear(false);
+		for (auto it : TypeRegistry::Get())
+		{
+			if (PassFilter(it.second))
+			{
+				rows.Add(it.second);
+			}
+		}
+	}
+
+	bool ReflectionDebugger::PassFilter(Type* type) const
 	{
 		if (!HasAllFlags(categoryFilter, type->GetCategory()))
 		{
-			return;
+			return false;
+		}
+		if (!filter.IsActive())
+		{
+			return true;
 		}
 
 		static String idText;
@@ -81,11 +111,15 @@ namespace rift::Editor
 		Strings::FormatTo(idText, "{}", type->GetId());
 
 		StringView name = type->GetName();
-		if (!filter.PassFilter(idText.c_str(), idText.c_str() + idText.size())
-		    && !filter.PassFilter(name.data(), name.data() + name.size()))
-		{
-			return;
-		}
+		return filter.PassFilter(idText.c_str(), idText.c_str() + idText.size())
+		    || filter.PassFilter(name.data(), name.data() + name.size());
+	}
+
+	void ReflectionDebugger::DrawType(Type* type)
+	{
+		static String idText;
+		idText.clear();
+		Strings::FormatTo(idText, "{}", type->GetId());
 
 		UI::TableNextRow();
 
@@ -99,7 +133,7 @@ namespace rift::Editor
 		UI::Text(categories);
 
 		UI::TableSetColumnIndex(2);    // Name
-		UI::Text(name);
+		UI::Text(type->GetName());
 
 		if (const auto* dataType = Cast<DataType>(type))
 		{
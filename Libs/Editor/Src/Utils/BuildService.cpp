@@ -0,0 +1,187 @@
+// Copyright 2015-2023 Piperift - All rights reserved
+
+#include "Utils/BuildService.h"
+
+#include <AST/Utils/ModuleUtils.h>
+#include <Compiler/Backend.h>
+#include <Compiler/Compiler.h>
+#include <Pipe/Core/Log.h>
+#include <Pipe/Core/Profiler.h>
+#include <UI/Window.h>
+
+
+namespace rift::Editor
+{
+	BuildService::~BuildService()
+	{
+		Cancel();
+		Join();
+	}
+
+	void BuildService::Start(
+	    AST::Tree& ast, p::ClassType* backendType, const CompilerConfig& config)
+	{
+		Cancel();
+		Join();
+
+		this->backendType = backendType;
+		this->config      = config;
+		pendingRestart    = false;
+		editVersion       = AST::GetEditVersion(ast);
+		{
+			// The project can't be read while the editor modifies it. The snapshot is only
+			// copied again if the project changed since the last one
+			std::scoped_lock lock{snapshotMutex};
+			snapshot = AST::TakeSnapshot(ast);
+		}
+		SetStage("Starting");
+		cancelled = false;
+		building  = true;
+
+		thread = std::thread([this]() {
+			Run();
+		});
+	}
+
+	void BuildService::Cancel()
+	{
+		if (building)
+		{
+			cancelled = true;
+		}
+		pendingRestart = false;
+
+		// Waits for the build thread if it is still copying the snapshot
+		std::scoped_lock lock{snapshotMutex};
+		snapshot = {};
+	}
+
+	void BuildService::Tick(AST::Tree& ast)
+	{
+		ZoneScoped;
+		{
+			std::scoped_lock lock{toastsMutex};
+			for (UI::Toast& toast : pendingToasts)
+			{
+				UI::AddNotification(Move(toast));
+			}
+			pendingToasts.Clear(false);
+		}
+
+		if (building && restartOnEdit && !cancelled && AST::GetEditVersion(ast) != editVersion)
+		{
+			cancelled      = true;
+			pendingRestart = true;
+		}
+
+		if (!building && thread.joinable())
+		{
+			Join();
+			if (pendingRestart)
+			{
+				Notify(UI::ToastType::Info, "Project changed. Restarting build");
+				Start(ast, backendType, config);
+			}
+		}
+	}
+
+	p::String BuildService::GetStage() const
+	{
+		std::scoped_lock lock{stageMutex};
+		return stage;
+	}
+
+	void BuildService::Run()
+	{
+		ZoneScopedN("Background Build");
+		{
+			// Building modifies the tree, so the snapshot is copied
+			SetStage("Copying project");
+			std::scoped_lock lock{snapshotMutex};
+			if (snapshot)
+			{
+				tree     = MakeOwned<AST::Tree>(*snapshot);
+				snapshot = {};
+			}
+		}
+		if (!tree)
+		{
+			// Cancelled before the project was copied
+			Notify(UI::ToastType::Warning, "Build cancelled");
+			building = false;
+			UI::WakeUp();
+			return;
+		}
+		// Copies don't keep the hooks and statics of the systems bound to the project
+		AST::InitProjectSystems(*tree);
+
+		{
+			Compiler compiler{*tree, config};
+			compiler.cancelFlag = &cancelled;
+			compiler.onProgress = [this](StringView stage) {
+				SetStage(stage);
+			};
+			// Errors are shown as they are found
+			compiler.onError = [this, &compiler](const CompileError& error) {
+				if (compiler.GetErrors().Size() <= maxErrorToasts)
+				{
+					Notify(UI::ToastType::Error, error.text);
+				}
+			};
+
+			if (backendType)
+			{
+				TOwnPtr<Backend> backend = MakeOwned<Backend>(backendType);
+				Build(compiler, backend);
+			}
+			else
+			{
+				compiler.AddError("Invalid backend.");
+			}
+
+			if (cancelled)
+			{
+				Notify(UI::ToastType::Warning, "Build cancelled");
+			}
+			else if (compiler.HasErrors())
+			{
+				const i32 errorCount = compiler.GetErrors().Size();
+				Notify(UI::ToastType::Error,
+				    errorCount > maxErrorToasts
+				        ? Strings::Format("Build failed: {} errors. See the log", errorCount)
+				        : Strings::Format("Build failed: {} errors", errorCount));
+			}
+			else
+			{
+				Notify(UI::ToastType::Success, "Build complete");
+			}
+		}
+		// Released from the build thread
+		tree = {};
+		building = false;
+		// The editor may be idle. Wake it up to join the build
+		UI::WakeUp();
+	}
+
+	void BuildService::Join()
+	{
+		if (thread.joinable())
+		{
+			thread.join();
+		}
+	}
+
+	void BuildService::SetStage(p::StringView newStage)
+	{
+		std::scoped_lock lock{stageMutex};
+		stage = newStage;
+		UI::WakeUp();
+	}
+
+	void BuildService::Notify(UI::ToastType type, p::String message)
+	{
+		std::scoped_lock lock{toastsMutex};
+		pendingToasts.Add({type, 3.f, "Build", Move(message)});
+		UI::WakeUp();
+	}
+}    // namespace rift::Editor
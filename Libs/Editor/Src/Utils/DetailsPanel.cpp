@@ -14,6 +14,7 @@
 #include "Utils/Widgets.h"
 
 #include <AST/Utils/Expressions.h>
+#include <AST/Utils/References.h>
 #include <AST/Utils/TypeUtils.h>
 #include <GLFW/glfw3.h>
 #include <IconsFontAwesome5.h>
@@ -71,7 +72,8 @@ namespace rift::Editor
 		{
 			ScopedChange(ast, id);
 			ast.GetOrAdd<AST::CExprTypeId>(id).id = typeId;
-			type->type                            = AST::GetNamespace(ast, typeId);
+			AST::MarkReferencesChanged<AST::CExprTypeId>(ast, id);
+			type->type = AST::GetNamespace(ast, typeId);
 		}
 		UI::PopStyleVar();
 		if (UI::IsItemHovered())
@@ -100,6 +102,7 @@ namespace rift::Editor
 		}
 		if (removePin)
 		{
+			ScopedChange(ast, id);
 			AST::RemoveExprInputPin(ast, AST::GetExprInputFromPin(ast, id));
 			AST::RemoveExprOutputPin(ast, AST::GetExprOutputFromPin(ast, id));
 		}
@@ -13,7 +13,9 @@
 #include "Utils/Nodes.h"
 #include "Utils/Widgets.h"
 
+#include <AST/Systems/TypeSystem.h>
 #include <AST/Utils/Expressions.h>
+#include <AST/Utils/TransactionUtils.h>
 #include <AST/Utils/TypeUtils.h>
 #include <GLFW/glfw3.h>
 #include <IconsFontAwesome5.h>
@@ -42,8 +44,8 @@ namespace rift::Editor
 
 		ImGui::PushID(ns);
 
-		const Color color =
-		    GetTypeColor(static_cast<AST::Tree&>(access.GetContext()), variableDecl->typeId);
+		auto& ast         = static_cast<AST::Tree&>(access.GetContext());
+		const Color color = GetTypeColor(ast, variableDecl->typeId);
 		static constexpr float frameHeight = 20.f;
 
 		UI::TableNextColumn();
@@ -103,6 +105,7 @@ namespace rift::Editor
 		if (UI::MutableText(nameId, name,
 		        ImGuiInputTextFlags_AutoSelectAll | ImGuiInputTextFlags_EnterReturnsTrue))
 		{
+			ScopedChange(ast, variableId);
 			ns->name = Tag{name};
 		}
 
@@ -110,7 +113,14 @@ namespace rift::Editor
 		{
 			UI::PushStyleVar(ImGuiStyleVar_FrameRounding, 2.f);
 			UI::SetNextItemWidth(-FLT_MIN);
-			Editor::TypeCombo(access, "##type", variableDecl->typeId);
+			// The new type is applied inside the transaction so that undo records it
+			AST::Id typeId = variableDecl->typeId;
+			if (Editor::TypeCombo(access, "##type", typeId))
+			{
+				ScopedChange(ast, variableId);
+				variableDecl->typeId = typeId;
+				AST::TypeSystem::MarkVariableRefsDirty(ast, variableId);
+			}
 			UI::PopStyleVar();
 		}
 
@@ -185,13 +185,63 @@ namespace rift::Editor::Graph
 		}
 	}
 
+	// @return true if the editor position must follow the node position in the AST
+	bool ShouldSyncNodePosition(AST::Id id)
+	{
+		const auto* context = Nodes::GetCurrentContext();
+		return UI::IsWindowAppearing()
+		    || (!context->leftMouseDragging && !context->leftMouseReleased
+		        && !Nodes::IsNodeSelected(id));
+	}
+
+	// Saves the node position after it was moved in the editor
+	void CommitNodePosition(
+	    const AST::TransactionAccess& access, AST::Id id, CNodePosition& transform)
+	{
+		if (Nodes::GetCurrentContext()->leftMouseReleased)
+		{
+			v2 newPosition = GetNodePosition(id);
+			if (!newPosition.Equals(transform.position, 0.1f))
+			{
+				ScopedChange(access, id);
+				transform.position = newPosition;
+			}
+		}
+	}
+
+	// Nodes out of the visible canvas or too zoomed out are kept by the editor instead of laid
+	// out. Kept nodes are drawn as a box with the title.
+	// @return true if the node was culled and must not be drawn
+	bool CullNode(TAccessRef<TWrite<CNodePosition>, TWrite<AST::CChanged>,
+	                  TWrite<AST::CFileDirty>, AST::CChild, AST::CFileRef>
+	                  access,
+	    AST::Id id, StringView title = {})
+	{
+		if (Nodes::ShouldLayoutNode(id))
+		{
+			return false;
+		}
+
+		auto& transform = access.GetOrAdd<CNodePosition>(id);
+		if (ShouldSyncNodePosition(id))
+		{
+			// The position may have changed while out of view (e.g by undo)
+			SetNodePosition(id, transform.position);
+			if (Nodes::ShouldLayoutNode(id))
+			{
+				return false;
+			}
+		}
+		Nodes::KeepNode(id, title);
+		// Selected nodes can be dragged out of view
+		CommitNodePosition(access, id, transform);
+		return true;
+	}
+
 	void BeginNode(TAccessRef<TWrite<CNodePosition>> access, AST::Id id)
 	{
 		currentNodeTransform = &access.GetOrAdd<CNodePosition>(id);
-		auto* context        = Nodes::GetCurrentContext();
-		if (UI::IsWindowAppearing()
-		    || (!context->leftMouseDragging && !context->leftMouseReleased
-		        && !Nodes::IsNodeSelected(id)))
+		if (ShouldSyncNodePosition(id))
 		{
 			SetNodePosition(id, currentNodeTransform->position);
 		}
@@ -212,15 +262,9 @@ namespace rift::Editor::Graph
 		Nodes::EndNode();
 		Nodes::PopStyleColor(1);
 
-		if (currentNodeTransform && context->leftMouseReleased)
+		if (currentNodeTransform)
 		{
-			const AST::Id id = context->currentNodeId;
-			v2 newPosition   = GetNodePosition(id);
-			if (!newPosition.Equals(currentNodeTransform->position, 0.1f))
-			{
-				ScopedChange(access, id);
-				currentNodeTransform->position = newPosition;
-			}
+			CommitNodePosition(access, context->currentNodeId, *currentNodeTransform);
 		}
 		currentNodeTransform = nullptr;
 	}
@@ -350,6 +394,11 @@ namespace rift::Editor::Graph
 				name = ns->name;
 			}
 
+			if (CullNode(access, functionId, name.AsString()))
+			{
+				continue;
+			}
+
 			PushNodeBackgroundColor(UI::GetNeutralColor(0));
 			PushNodeTitleColor(functionColor);
 			BeginNode(access, functionId);
@@ -417,6 +466,10 @@ namespace rift::Editor::Graph
 			if (auto* call = access.TryGet<const AST::CExprCall>(id))
 			{
 				StringView functionName = call->function.Last().AsString();
+				if (CullNode(access, id, functionName))
+				{
+					continue;
+				}
 
 				PushNodeBackgroundColor(rift::UI::GetNeutralColor(0));
 				PushNodeTitleColor(callColor);
@@ -526,7 +579,10 @@ namespace rift::Editor::Graph
 	{
 		for (AST::Id id : FindIdsWith<AST::CStmtReturn>(access, children))
 		{
-			DrawReturnNode(access, id);
+			if (!CullNode(access, id, "Return"))
+			{
+				DrawReturnNode(access, id);
+			}
 		}
 	}
 
@@ -534,22 +590,34 @@ namespace rift::Editor::Graph
 	{
 		for (AST::Id id : FindIdsWith<AST::CLiteralBool>(ast, children))
 		{
-			DrawLiteralBool(ast, id, ast.Get<AST::CLiteralBool>(id).value);
+			if (!CullNode(ast, id))
+			{
+				DrawLiteralBool(ast, id, ast.Get<AST::CLiteralBool>(id).value);
+			}
 		}
 
 		for (AST::Id id : FindIdsWith<AST::CLiteralIntegral>(ast, children))
 		{
-			DrawLiteralIntegral(ast, id, ast.Get<AST::CLiteralIntegral>(id));
+			if (!CullNode(ast, id))
+			{
+				DrawLiteralIntegral(ast, id, ast.Get<AST::CLiteralIntegral>(id));
+			}
 		}
 
 		for (AST::Id id : FindIdsWith<AST::CLiteralFloating>(ast, children))
 		{
-			DrawLiteralFloating(ast, id, ast.Get<AST::CLiteralFloating>(id));
+			if (!CullNode(ast, id))
+			{
+				DrawLiteralFloating(ast, id, ast.Get<AST::CLiteralFloating>(id));
+			}
 		}
 
 		for (AST::Id id : FindIdsWith<AST::CLiteralString>(ast, children))
 		{
-			DrawLiteralString(ast, id, ast.Get<AST::CLiteralString>(id).value);
+			if (!CullNode(ast, id))
+			{
+				DrawLiteralString(ast, id, ast.Get<AST::CLiteralString>(id).value);
+			}
 		}
 	}
 
@@ -559,6 +627,16 @@ namespace rift::Editor::Graph
 		for (AST::Id id : FindIdsWith<AST::CExprDeclRefId>(ast, children))
 		{
 			AST::Id variableId = ast.Get<const AST::CExprDeclRefId>(id).declarationId;
+			StringView name    = "Invalid";
+			if (ast.IsValid(variableId) && ast.Has<AST::CNamespace>(variableId))
+			{
+				name = ast.Get<const AST::CNamespace>(variableId).name.AsString();
+			}
+
+			if (CullNode(ast, id, name))
+			{
+				continue;
+			}
 
 			const AST::CExprTypeId* exprType = ast.TryGet<AST::CExprTypeId>(id);
 			AST::Id typeId                   = exprType ? exprType->id : AST::NoId;
@@ -570,11 +648,6 @@ namespace rift::Editor::Graph
 			{
 				BeginExprOutput(ast, id, false);
 				PushInnerNodeStyle();
-				StringView name = "Invalid";
-				if (ast.IsValid(variableId) && ast.Has<AST::CNamespace>(variableId))
-				{
-					name = ast.Get<const AST::CNamespace>(variableId).name.AsString();
-				}
 				UI::Text(name);
 				PopInnerNodeStyle();
 				EndExprOutput(false);
@@ -596,6 +669,11 @@ namespace rift::Editor::Graph
 		for (AST::Id id :
 		    FindIdsWith<AST::CStmtIf, AST::CExprInputs, AST::CStmtOutputs>(access, children))
 		{
+			if (CullNode(access, id, "if"))
+			{
+				continue;
+			}
+
 			BeginNode(access, id);
 			{
 				Nodes::BeginNodeTitleBar();
@@ -659,6 +737,13 @@ namespace rift::Editor::Graph
 	{
 		for (AST::Id id : FindIdsWith<AST::CExprUnaryOperator>(access, children))
 		{
+			const auto& op       = access.Get<const AST::CExprUnaryOperator>(id);
+			StringView shortName = Editor::GetUnaryOperatorName(op.type);
+			if (CullNode(access, id, shortName))
+			{
+				continue;
+			}
+
 			static constexpr Color color = UI::GetNeutralColor(0);
 
 			PushNodeBackgroundColor(color);
@@ -670,8 +755,6 @@ namespace rift::Editor::Graph
 				EndExprInput(false);
 				UI::SameLine();
 
-				const auto& op       = access.Get<const AST::CExprUnaryOperator>(id);
-				StringView shortName = Editor::GetUnaryOperatorName(op.type);
 				UI::Text(shortName);
 
 				UI::SameLine();
@@ -693,6 +776,13 @@ namespace rift::Editor::Graph
 		TArray<AST::Id> pinIds;
 		for (AST::Id id : FindIdsWith<AST::CExprBinaryOperator>(access, children))
 		{
+			const auto& op       = access.Get<const AST::CExprBinaryOperator>(id);
+			StringView shortName = Editor::GetBinaryOperatorName(op.type);
+			if (CullNode(access, id, shortName))
+			{
+				continue;
+			}
+
 			static constexpr Color color = UI::GetNeutralColor(0);
 			PushNodeBackgroundColor(color);
 
@@ -715,8 +805,6 @@ namespace rift::Editor::Graph
 				UI::EndGroup();
 				UI::SameLine();
 
-				const auto& op       = access.Get<const AST::CExprBinaryOperator>(id);
-				StringView shortName = Editor::GetBinaryOperatorName(op.type);
 				UI::Text(shortName);
 
 				UI::SameLine();
@@ -799,6 +887,13 @@ namespace rift::Editor::Graph
 					continue;
 				}
 
+				if (!Nodes::IsLinkVisible(i32(inputId)))
+				{
+					// Out of view links are only kept for selection. Skip resolving their color
+					Nodes::Link(i32(inputId), i32(output.pinId), i32(inputId));
+					continue;
+				}
+
 				Color color = GetTypeColor<void>();
 				if (access.Has<AST::CInvalid>(inputId) || access.Has<AST::CInvalid>(output.pinId))
 				{
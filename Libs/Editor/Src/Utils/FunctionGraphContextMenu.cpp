@@ -19,6 +19,7 @@
 #include <AST/Components/Views/CNodePosition.h>
 #include <AST/Statics/STypes.h>
 #include <AST/Utils/Expressions.h>
+#include <AST/Utils/References.h>
 #include <AST/Utils/Statements.h>
 #include <AST/Utils/TransactionUtils.h>
 #include <GLFW/glfw3.h>
@@ -108,6 +109,14 @@ namespace rift::Editor::Graph
 			ast.AddN<AST::CCallDirty>(calls);
 		}
 
+		TArray<AST::Id> functions = FindIdsWith<AST::CDeclFunction>(ast, nodeIds);
+		if (!functions.IsEmpty() && UI::MenuItem("Refresh calls"))
+		{
+			TArray<AST::Id> references;
+			AST::FindReferences(ast, functions, references);
+			ast.AddN<AST::CCallDirty>(FindIdsWith<AST::CExprCallId>(ast, references));
+		}
+
 		if (canEditBody && UI::MenuItem("Delete"))
 		{
 			AST::RemoveNodes(ast, nodeIds);
@@ -3,6 +3,8 @@
 // the structure of this file:
 //
 // [SECTION] bezier curve helpers
+// [SECTION] spatial index
+// [SECTION] link geometry cache
 // [SECTION] draw list helper
 // [SECTION] ui state logic
 // [SECTION] render helpers
@@ -18,6 +20,7 @@
 #include <Pipe/Math/Bezier.h>
 
 #include <cassert>
+#include <cmath>
 #include <cstring>    // strlen, strncmp
 #include <new>
 
@@ -55,43 +58,11 @@ namespace rift::Nodes
 		return cubicBezier;
 	}
 
-	// Calculates the closest point along each bezier curve segment.
-	v2 GetClosestPointOnCubicBezier(const i32 numSegments, const v2& p, const CubicBezier& cb)
-	{
-		Ensure(numSegments > 0);
-		v2 pLast = cb.p0;
-		v2 pClosest;
-		float pClosestDist = FLT_MAX;
-		float tStep        = 1.0f / (float)numSegments;
-		for (i32 i = 1; i <= numSegments; ++i)
-		{
-			v2 pCurrent = p::EvaluateCubicBezier(cb.p0, cb.p1, cb.p2, cb.p3, tStep * i);
-			v2 pLine    = Vectors::ClosestPointInLine(pLast, pCurrent, p);
-			float dist  = (p - pLine).LengthSquared();
-			if (dist < pClosestDist)
-			{
-				pClosest     = pLine;
-				pClosestDist = dist;
-			}
-			pLast = pCurrent;
-		}
-		return pClosest;
-	}
-
-	float GetDistanceToCubicBezier(
-	    const v2& pos, const CubicBezier& cubicBezier, const i32 numSegments)
-	{
-		const v2 pointOnCurve = GetClosestPointOnCubicBezier(numSegments, pos, cubicBezier);
-		return (pointOnCurve - pos).Length();
-	}
-
-	Rect GetContainingRectForCubicBezier(const CubicBezier& cb)
+	Rect GetContainingRectForCubicBezier(const CubicBezier& cb, float hoverDistance)
 	{
 		const v2 min = v2(math::Min(cb.p0.x, cb.p3.x), math::Min(cb.p0.y, cb.p3.y));
 		const v2 max = v2(math::Max(cb.p0.x, cb.p3.x), math::Max(cb.p0.y, cb.p3.y));
 
-		const float hoverDistance = gNodes->style.LinkHoverDistance;
-
 		Rect rect(min, max);
 		rect.Merge(cb.p1);
 		rect.Merge(cb.p2);
@@ -158,62 +129,6 @@ namespace rift::Nodes
 		return abs(sum) != sumAbs;
 	}
 
-	bool RectangleOverlapsBezier(const Rect& rectangle, const CubicBezier& cubicBezier)
-	{
-		v2 current = p::EvaluateCubicBezier(
-		    cubicBezier.p0, cubicBezier.p1, cubicBezier.p2, cubicBezier.p3, 0.f);
-
-		const float dt = 1.0f / cubicBezier.numSegments;
-		for (i32 s = 0; s < cubicBezier.numSegments; ++s)
-		{
-			const v2 next = p::EvaluateCubicBezier(cubicBezier.p0, cubicBezier.p1, cubicBezier.p2,
-			    cubicBezier.p3, float((s + 1) * dt));
-			if (RectangleOverlapsLineSegment(rectangle, current, next))
-			{
-				return true;
-			}
-			current = next;
-		}
-		return false;
-	}
-
-	bool RectangleOverlapsLink(
-	    const Rect& rectangle, const v2& start, const v2& end, const PinType startType)
-	{
-		// First level: simple rejection test via rectangle overlap:
-
-		Rect lrect = Rect(start, end);
-		if (lrect.min.x > lrect.max.x)
-		{
-			ImSwap(lrect.min.x, lrect.max.x);
-		}
-
-		if (lrect.min.y > lrect.max.y)
-		{
-			ImSwap(lrect.min.y, lrect.max.y);
-		}
-
-		if (rectangle.Overlaps(lrect))
-		{
-			// First, check if either one or both endpoinds are trivially contained
-			// in the rectangle
-
-			if (rectangle.Contains(start) || rectangle.Contains(end))
-			{
-				return true;
-			}
-
-			// Second level of refinement: do a more expensive test against the
-			// link
-
-			const CubicBezier cubicBezier =
-			    MakeCubicBezier(start, end, startType, gNodes->style.linkLineSegmentsPerLength);
-			return RectangleOverlapsBezier(rectangle, cubicBezier);
-		}
-
-		return false;
-	}
-
 	// [SECTION] coordinate space conversion helpers
 
 
@@ -222,24 +137,25 @@ namespace rift::Nodes
 		return gNodes->CanvasOriginScreenSpace + v;
 	}
 
+	// Panning is in screen units. Grid units are scaled by the zoom
 	v2 ScreenToGridPosition(const EditorContext& editor, const v2& v)
 	{
-		return v - gNodes->CanvasOriginScreenSpace - editor.panning;
+		return (v - gNodes->CanvasOriginScreenSpace - editor.panning) / editor.zoom;
 	}
 
 	v2 GridToScreenPosition(const EditorContext& editor, const v2& v)
 	{
-		return v + gNodes->CanvasOriginScreenSpace + editor.panning;
+		return v * editor.zoom + gNodes->CanvasOriginScreenSpace + editor.panning;
 	}
 
 	v2 GridToEditorPosition(const EditorContext& editor, const v2& v)
 	{
-		return v + editor.panning;
+		return v * editor.zoom + editor.panning;
 	}
 
 	v2 EditorToGridPosition(const EditorContext& editor, const v2& v)
 	{
-		return v - editor.panning;
+		return (v - editor.panning) / editor.zoom;
 	}
 
 	v2 MiniMapToGridPosition(const EditorContext& editor, const v2& v)
@@ -255,6 +171,20 @@ namespace rift::Nodes
 		     + editor.miniMap.contentScreenSpace.min;
 	};
 
+	Rect ScreenToGridRect(const EditorContext& editor, const Rect& rect)
+	{
+		return {ScreenToGridPosition(editor, rect.min), ScreenToGridPosition(editor, rect.max)};
+	}
+
+	// Canvas area in grid space, with a margin for pins and outlines out of node bounds
+	Rect GetVisibleGridRect(const EditorContext& editor)
+	{
+		const float margin = 32.f / editor.zoom;
+		Rect rect          = ScreenToGridRect(editor, gNodes->CanvasRectScreenSpace);
+		rect.Expand(v2{margin, margin});
+		return rect;
+	}
+
 	v2 ScreenToGridPosition(const v2& v)
 	{
 		return ScreenToGridPosition(GetEditorContext(), v);
@@ -281,6 +211,211 @@ namespace rift::Nodes
 	}
 
 
+	// [SECTION] spatial index
+
+	u64 GetCellKey(i32 x, i32 y)
+	{
+		return (u64(u32(x)) << 32) | u64(u32(y));
+	}
+
+	// Unlike Rect::Overlaps, also true for empty rects (like points) touching each other
+	bool RectsTouch(const Rect& one, const Rect& other)
+	{
+		return one.min.x <= other.max.x && other.min.x <= one.max.x && one.min.y <= other.max.y
+		    && other.min.y <= one.max.y;
+	}
+
+	SpatialGrid::CellRange SpatialGrid::GetCellRange(const Rect& rect) const
+	{
+		return {i32(std::floor(rect.min.x / cellSize)), i32(std::floor(rect.min.y / cellSize)),
+		    i32(std::floor(rect.max.x / cellSize)), i32(std::floor(rect.max.y / cellSize))};
+	}
+
+	void SpatialGrid::Update(i32 entry, const Rect& rect)
+	{
+		Check(entry >= 0);
+		if (entry >= rects.Size())
+		{
+			rects.Resize(entry + 1);
+			ranges.Resize(entry + 1);
+			inserted.Resize(entry + 1, false);
+			queryMarks.Resize(entry + 1, 0);
+		}
+
+		const CellRange range = GetCellRange(rect);
+		rects[entry]          = rect;
+		if (inserted[entry])
+		{
+			if (ranges[entry] == range)
+			{
+				// Still on the same cells
+				return;
+			}
+			Remove(entry);
+		}
+
+		ranges[entry]   = range;
+		inserted[entry] = true;
+		for (i32 y = range.minY; y <= range.maxY; ++y)
+		{
+			for (i32 x = range.minX; x <= range.maxX; ++x)
+			{
+				cells[GetCellKey(x, y)].Add(entry);
+			}
+		}
+	}
+
+	void SpatialGrid::Remove(i32 entry)
+	{
+		if (!inserted.IsValidIndex(entry) || !inserted[entry])
+		{
+			return;
+		}
+
+		const CellRange& range = ranges[entry];
+		for (i32 y = range.minY; y <= range.maxY; ++y)
+		{
+			for (i32 x = range.minX; x <= range.maxX; ++x)
+			{
+				if (TArray<i32>* cell = cells.Find(GetCellKey(x, y)))
+				{
+					cell->Remove(entry, false);
+				}
+			}
+		}
+		inserted[entry] = false;
+	}
+
+	void SpatialGrid::Query(const Rect& rect, TArray<i32>& results)
+	{
+		if (++queryMark == 0)
+		{
+			// Marks wrapped around. Old marks could match the new one
+			for (u32& mark : queryMarks)
+			{
+				mark = 0;
+			}
+			queryMark = 1;
+		}
+
+		const CellRange range = GetCellRange(rect);
+		for (i32 y = range.minY; y <= range.maxY; ++y)
+		{
+			for (i32 x = range.minX; x <= range.maxX; ++x)
+			{
+				const TArray<i32>* cell = cells.Find(GetCellKey(x, y));
+				if (!cell)
+				{
+					continue;
+				}
+				for (i32 entry : *cell)
+				{
+					if (queryMarks[entry] != queryMark && RectsTouch(rects[entry], rect))
+					{
+						queryMarks[entry] = queryMark;
+						results.Add(entry);
+					}
+				}
+			}
+		}
+	}
+
+	void SpatialGrid::Clear()
+	{
+		cells.Clear();
+		rects.Clear();
+		ranges.Clear();
+		inserted.Clear();
+		queryMarks.Clear();
+		queryMark = 0;
+	}
+
+
+	// [SECTION] link geometry cache
+
+	const LinkGeometry& GetLinkGeometry(EditorContext& editor, const i32 linkIdx)
+	{
+		if (linkIdx >= editor.linkGeometries.Size())
+		{
+			editor.linkGeometries.Resize(linkIdx + 1);
+		}
+		LinkGeometry& geometry = editor.linkGeometries[linkIdx];
+
+		const LinkData& link          = editor.links.pool[linkIdx];
+		const PinData& outputPin      = editor.outputs.pool[link.outputIdx];
+		const PinData& inputPin       = editor.inputs.pool[link.inputIdx];
+		const v2 start                = ScreenToGridPosition(editor, outputPin.position);
+		const v2 end                  = ScreenToGridPosition(editor, inputPin.position);
+		// Zoomed out links get fewer segments. Style values are in screen units
+		const float segmentsPerLength = gNodes->style.linkLineSegmentsPerLength * editor.zoom;
+		const float hoverDistance     = gNodes->style.LinkHoverDistance / editor.zoom;
+
+		// Pin positions come from screen space, so panning can add some rounding noise
+		constexpr float toleranceSqr = 0.01f * 0.01f;
+		if ((start - geometry.start).LengthSquared() <= toleranceSqr
+		    && (end - geometry.end).LengthSquared() <= toleranceSqr
+		    && segmentsPerLength == geometry.segmentsPerLength
+		    && hoverDistance == geometry.hoverDistance)
+		{
+			return geometry;
+		}
+
+		geometry.start             = start;
+		geometry.end               = end;
+		geometry.segmentsPerLength = segmentsPerLength;
+		geometry.hoverDistance     = hoverDistance;
+		geometry.bezier = MakeCubicBezier(start, end, PinType::Output, segmentsPerLength);
+		geometry.bounds = GetContainingRectForCubicBezier(geometry.bezier, hoverDistance);
+
+		const CubicBezier& cb = geometry.bezier;
+		geometry.points.Resize(cb.numSegments + 1);
+		geometry.points[0] = cb.p0;
+		const float tStep  = 1.0f / float(cb.numSegments);
+		for (i32 i = 1; i <= cb.numSegments; ++i)
+		{
+			geometry.points[i] = p::EvaluateCubicBezier(cb.p0, cb.p1, cb.p2, cb.p3, tStep * i);
+		}
+		return geometry;
+	}
+
+	float GetDistanceToLinkGeometry(const v2& pos, const LinkGeometry& geometry)
+	{
+		float closestDistanceSqr = FLT_MAX;
+		for (i32 i = 1; i < geometry.points.Size(); ++i)
+		{
+			const v2 pLine =
+			    Vectors::ClosestPointInLine(geometry.points[i - 1], geometry.points[i], pos);
+			closestDistanceSqr = math::Min(closestDistanceSqr, (pos - pLine).LengthSquared());
+		}
+		return std::sqrt(closestDistanceSqr);
+	}
+
+	bool RectangleOverlapsLinkGeometry(const Rect& rect, const LinkGeometry& geometry)
+	{
+		// First level: simple rejection test via rectangle overlap
+		if (!rect.Overlaps(geometry.bounds))
+		{
+			return false;
+		}
+
+		// Check if either one or both endpoints are trivially contained in the rectangle
+		if (rect.Contains(geometry.start) || rect.Contains(geometry.end))
+		{
+			return true;
+		}
+
+		// Second level of refinement: test against the tessellated link
+		for (i32 i = 1; i < geometry.points.Size(); ++i)
+		{
+			if (RectangleOverlapsLineSegment(rect, geometry.points[i - 1], geometry.points[i]))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+
 	// [SECTION] draw list helper
 
 	void ImDrawListGrowChannels(ImDrawList* drawList, const i32 numChannels)
@@ -366,7 +501,10 @@ namespace rift::Nodes
 	void DrawListSet(ImDrawList* windowDrawList)
 	{
 		gNodes->CanvasDrawList = windowDrawList;
-		gNodes->NodeIdxToSubmissionIdx.Clear();
+		for (AST::Id nodeId : gNodes->nodeSubmissionOrder)
+		{
+			gNodes->nodeIdxToSubmissionIdx[i32(GetIdIndex(nodeId))] = NO_INDEX;
+		}
 		gNodes->nodeSubmissionOrder.clear();
 	}
 
@@ -391,8 +529,12 @@ namespace rift::Nodes
 
 	void DrawListAddNode(AST::Id nodeId)
 	{
-		gNodes->NodeIdxToSubmissionIdx.SetInt(
-		    static_cast<ImGuiID>(GetIdIndex(nodeId)), gNodes->nodeSubmissionOrder.Size);
+		const i32 index = i32(GetIdIndex(nodeId));
+		if (index >= gNodes->nodeIdxToSubmissionIdx.Size())
+		{
+			gNodes->nodeIdxToSubmissionIdx.Resize(index + 1, NO_INDEX);
+		}
+		gNodes->nodeIdxToSubmissionIdx[index] = gNodes->nodeSubmissionOrder.Size;
 		gNodes->nodeSubmissionOrder.push_back(nodeId);
 		ImDrawListGrowChannels(gNodes->CanvasDrawList, 2);
 	}
@@ -431,8 +573,10 @@ namespace rift::Nodes
 
 	void DrawListActivateNodeBackground(AST::Id nodeId)
 	{
-		const i32 submissionIdx =
-		    gNodes->NodeIdxToSubmissionIdx.GetInt(static_cast<ImGuiID>(GetIdIndex(nodeId)), -1);
+		const i32 index         = i32(GetIdIndex(nodeId));
+		const i32 submissionIdx = gNodes->nodeIdxToSubmissionIdx.IsValidIndex(index)
+		                            ? gNodes->nodeIdxToSubmissionIdx[index]
+		                            : NO_INDEX;
 		// There is a discrepancy in the submitted node count and the rendered node count! Did
 		// you call one of the following functions
 		// * MoveToNode
@@ -440,7 +584,7 @@ namespace rift::Nodes
 		// * SetNodeGridSpacePos
 		// * SetNodeDraggable
 		// after the BeginNode/EndNode function calls?
-		assert(submissionIdx != -1);
+		assert(submissionIdx != NO_INDEX);
 		const i32 backgroundChannelIdx = DrawListSubmissionIdxToBackgroundChannelIdx(submissionIdx);
 		gNodes->CanvasDrawList->_Splitter.SetCurrentChannel(
 		    gNodes->CanvasDrawList, backgroundChannelIdx);
@@ -463,68 +607,73 @@ namespace rift::Nodes
 
 	void DrawListSortChannelsByDepth(const TArray<AST::Id>& nodeDepthOrder)
 	{
-		if (gNodes->NodeIdxToSubmissionIdx.Data.Size < 2)
+		const i32 count = gNodes->nodeSubmissionOrder.Size;
+		if (count < 2)
 		{
 			return;
 		}
 
-		assert(nodeDepthOrder.Size() == gNodes->nodeSubmissionOrder.Size);
+		assert(nodeDepthOrder.Size() == count);
 
-		i32 startIdx = nodeDepthOrder.Size() - 1;
-		while (nodeDepthOrder[startIdx] == gNodes->nodeSubmissionOrder[startIdx])
+		// Depth order is stable across frames. Usually only selected nodes move
+		i32 firstIdx = 0;
+		while (nodeDepthOrder[firstIdx] == gNodes->nodeSubmissionOrder[firstIdx])
 		{
-			if (--startIdx == 0)
+			if (++firstIdx == count)
 			{
 				// early out if submission order and depth order are the same
 				return;
 			}
 		}
 
-		// TODO: this is an O(N^2) algorithm. It might be worthwhile revisiting this to see if
-		// the time complexity can be reduced.
-
-		for (i32 depthIdx = startIdx; depthIdx > 0; --depthIdx)
+		TArray<i32>& sourceIdx = gNodes->depthToSubmissionIdx;
+		sourceIdx.Resize(count);
+		for (i32 depthIdx = 0; depthIdx < count; ++depthIdx)
 		{
-			const AST::Id nodeId = nodeDepthOrder[depthIdx];
-
-			// Find the current index of the nodeIdx in the submission order array
-			i32 submissionIdx = -1;
-			for (i32 i = 0; i < gNodes->nodeSubmissionOrder.Size; ++i)
-			{
-				if (gNodes->nodeSubmissionOrder[i] == nodeId)
-				{
-					submissionIdx = i;
-					break;
-				}
-			}
-			assert(submissionIdx >= 0);
+			const i32 index     = i32(GetIdIndex(nodeDepthOrder[depthIdx]));
+			sourceIdx[depthIdx] = gNodes->nodeIdxToSubmissionIdx[index];
+			assert(sourceIdx[depthIdx] != NO_INDEX);
+		}
 
-			if (submissionIdx == depthIdx)
+		// Apply the permutation one cycle at a time. Each channel pair is swapped into place
+		// once, and swapping channels only swaps their buffers
+		for (i32 startIdx = firstIdx; startIdx < count; ++startIdx)
+		{
+			i32 currentIdx = startIdx;
+			i32 nextIdx    = sourceIdx[currentIdx];
+			while (nextIdx != startIdx)
 			{
-				continue;
+				DrawListSwapSubmissionIndices(currentIdx, nextIdx);
+				sourceIdx[currentIdx] = currentIdx;
+				currentIdx            = nextIdx;
+				nextIdx               = sourceIdx[currentIdx];
 			}
+			sourceIdx[currentIdx] = currentIdx;
+		}
 
-			for (i32 j = submissionIdx; j < depthIdx; ++j)
-			{
-				DrawListSwapSubmissionIndices(j, j + 1);
-				ImSwap(gNodes->nodeSubmissionOrder[j], gNodes->nodeSubmissionOrder[j + 1]);
-			}
+		for (i32 depthIdx = firstIdx; depthIdx < count; ++depthIdx)
+		{
+			const AST::Id nodeId                                    = nodeDepthOrder[depthIdx];
+			gNodes->nodeSubmissionOrder[depthIdx]                   = nodeId;
+			gNodes->nodeIdxToSubmissionIdx[i32(GetIdIndex(nodeId))] = depthIdx;
 		}
 	}
 
 	// [SECTION] ui state logic
 
-	v2 GetScreenSpacePinCoordinates(const Rect& nodeRect, const PinType type, const Rect& pinRect)
+	v2 GetScreenSpacePinCoordinates(
+	    const Rect& nodeRect, const PinType type, const Rect& pinRect, float zoom)
 	{
-		const float x = type == PinType::Input ? (nodeRect.min.x - gNodes->style.PinOffset)
-		                                       : (nodeRect.max.x + gNodes->style.PinOffset);
+		const float offset = gNodes->style.PinOffset * zoom;
+		const float x =
+		    type == PinType::Input ? (nodeRect.min.x - offset) : (nodeRect.max.x + offset);
 		return {x, 0.5f * (pinRect.min.y + pinRect.max.y)};
 	}
 
 	v2 GetScreenSpacePinCoordinates(const EditorContext& editor, PinType type, const PinData& pin)
 	{
 		const Rect& parentNodeRect = editor.nodes.Get(pin.parentNodeId).rect;
-		return GetScreenSpacePinCoordinates(parentNodeRect, type, pin.rect);
+		return GetScreenSpacePinCoordinates(parentNodeRect, type, pin.rect, editor.zoom);
 	}
 
 	bool IsMouseInCanvas()
@@ -577,8 +726,7 @@ namespace rift::Nodes
 		// To support snapping of multiple nodes, we need to store the offset of
 		// each node in the selection to the origin of the dragged node.
 		const v2 refOrigin = editor.nodes.Get(nodeId).Origin;
-		editor.PrimaryNodeOffset =
-		    refOrigin + gNodes->CanvasOriginScreenSpace + editor.panning - gNodes->mousePosition;
+		editor.PrimaryNodeOffset = GridToScreenPosition(editor, refOrigin) - gNodes->mousePosition;
 
 		editor.SelectedNodeOrigins.clear();
 		for (AST::Id id : editor.selectedNodeIds)
@@ -720,14 +868,18 @@ namespace rift::Nodes
 
 		editor.selectedNodeIds.Clear();
 
-		// Test for overlap against node rectangles
+		// Test for overlap against node rectangles near the box
 
-		for (AST::Id nodeId : editor.nodes)
+		const Rect gridBoxRect  = ScreenToGridRect(editor, boxRect);
+		TArray<i32>& candidates = gNodes->gridQueryResults;
+		candidates.Clear(false);
+		editor.nodeGrid.Query(gridBoxRect, candidates);
+		for (i32 nodeIndex : candidates)
 		{
-			NodeData& node = editor.nodes.Get(nodeId);
-			if (boxRect.Overlaps(node.rect))
+			const NodeData& node = editor.nodes.data[nodeIndex];
+			if (editor.nodes.Contains(node.id) && boxRect.Overlaps(node.rect))
 			{
-				editor.selectedNodeIds.Add(nodeId);
+				editor.selectedNodeIds.Add(node.id);
 			}
 		}
 
@@ -735,26 +887,16 @@ namespace rift::Nodes
 
 		editor.selectedLinkIndices.clear();
 
-		// Test for overlap against links
+		// Test for overlap against links near the box
 
-		for (i32 linkIdx = 0; linkIdx < editor.links.pool.Size(); ++linkIdx)
+		candidates.Clear(false);
+		editor.linkGrid.Query(gridBoxRect, candidates);
+		for (i32 linkIdx : candidates)
 		{
 			if (editor.links.inUse.IsSet(linkIdx))
 			{
-				const LinkData& link = editor.links.pool[linkIdx];
-
-				const PinData& outputPin  = editor.outputs.pool[link.outputIdx];
-				const PinData& inputPin   = editor.inputs.pool[link.inputIdx];
-				const Rect& nodeStartRect = editor.nodes[outputPin.parentNodeId].rect;
-				const Rect& nodeEndRect   = editor.nodes[inputPin.parentNodeId].rect;
-
-				const v2 start =
-				    GetScreenSpacePinCoordinates(nodeStartRect, PinType::Output, outputPin.rect);
-				const v2 end =
-				    GetScreenSpacePinCoordinates(nodeEndRect, PinType::Input, inputPin.rect);
-
 				// Test
-				if (RectangleOverlapsLink(boxRect, start, end, PinType::Output))
+				if (RectangleOverlapsLinkGeometry(gridBoxRect, GetLinkGeometry(editor, linkIdx)))
 				{
 					editor.selectedLinkIndices.push_back(linkIdx);
 				}
@@ -844,9 +986,8 @@ namespace rift::Nodes
 	{
 		if (gNodes->leftMouseDragging || gNodes->leftMouseReleased)
 		{
-			const v2 origin =
-			    SnapOriginToGrid(gNodes->mousePosition - gNodes->CanvasOriginScreenSpace
-			                     - editor.panning + editor.PrimaryNodeOffset);
+			const v2 origin = SnapOriginToGrid(
+			    ScreenToGridPosition(editor, gNodes->mousePosition + editor.PrimaryNodeOffset));
 			for (i32 i = 0; i < editor.selectedNodeIds.Size(); ++i)
 			{
 				const v2 nodeRel     = editor.SelectedNodeOrigins[i];
@@ -958,7 +1099,7 @@ namespace rift::Nodes
 
 		gNodes->CanvasDrawList->AddBezierCubic(cubicBezier.p0, cubicBezier.p1, cubicBezier.p2,
 		    cubicBezier.p3, gNodes->style.colors[ColorVar_Link].ToPackedABGR(),
-		    gNodes->style.LinkThickness, cubicBezier.numSegments);
+		    math::Max(gNodes->style.LinkThickness * editor.zoom, 1.f), cubicBezier.numSegments);
 
 		const bool linkCreationOnSnap =
 		    gNodes->HoveredPinIdx
@@ -1009,6 +1150,14 @@ namespace rift::Nodes
 		}
 	}
 
+	// Changes the zoom keeping the grid position under a screen position in place
+	void ZoomAround(EditorContext& editor, const v2& screenPivot, float zoom)
+	{
+		const v2 gridPivot = ScreenToGridPosition(editor, screenPivot);
+		editor.zoom    = math::Clamp(zoom, gNodes->style.minZoom, gNodes->style.maxZoom);
+		editor.panning = screenPivot - gNodes->CanvasOriginScreenSpace - gridPivot * editor.zoom;
+	}
+
 	void UpdatePanning(EditorContext& editor)
 	{
 		const bool dragging = gNodes->altMouseDragging;
@@ -1048,72 +1197,62 @@ namespace rift::Nodes
 		}
 	}
 
-	void ResolveOccludedPins(const EditorContext& editor, ImVector<PinIdx>& occludedPinIndices)
+	// @return true if a node above the pin's parent node in the depth stack covers the pin
+	bool IsPinOccluded(EditorContext& editor, const PinData& pin)
 	{
-		const TArray<AST::Id>& depthStack = editor.nodes.depthOrder;
-
-		occludedPinIndices.resize(0);
+		const v2 gridPos = ScreenToGridPosition(editor, pin.position);
 
-		if (depthStack.Size() < 2)
+		TArray<i32>& nodeIndices = gNodes->occlusionQueryResults;
+		nodeIndices.Clear(false);
+		editor.nodeGrid.Query(Rect{gridPos, gridPos}, nodeIndices);
+		if (nodeIndices.Size() < 2)
 		{
-			return;
+			// Only the parent node (if any) is there
+			return false;
 		}
 
-		// For each node in the depth stack
-		for (i32 i = 0; i < (depthStack.Size() - 1); ++i)
+		const TArray<AST::Id>& depthStack = editor.nodes.depthOrder;
+		const i32 pinDepth                = depthStack.FindIndex(pin.parentNodeId);
+		for (i32 nodeIndex : nodeIndices)
 		{
-			const NodeData& nodeBelow = editor.nodes[depthStack[i]];
-
-			// Iterate over the rest of the depth stack to find nodes overlapping the pins
-			for (i32 e = i + 1; e < depthStack.Size(); ++e)
+			const NodeData& node = editor.nodes.data[nodeIndex];
+			if (node.id == pin.parentNodeId || !editor.nodes.Contains(node.id)
+			    || !node.rect.Contains(pin.position))
 			{
-				const Rect& rectAbove = editor.nodes[depthStack[e]].rect;
-
-				// Iterate over each pin
-				for (i32 i = 0; i < nodeBelow.inputs.Size; ++i)
-				{
-					const i32 pinIdx = nodeBelow.inputs[i];
-					const v2& pinPos = editor.inputs.pool[pinIdx].position;
-
-					if (rectAbove.Contains(pinPos))
-					{
-						occludedPinIndices.push_back({pinIdx, PinType::Input});
-					}
-				}
-				for (i32 i = 0; i < nodeBelow.outputs.Size; ++i)
-				{
-					const i32 pinIdx = nodeBelow.outputs[i];
-					const v2& pinPos = editor.outputs.pool[pinIdx].position;
-
-					if (rectAbove.Contains(pinPos))
-					{
-						occludedPinIndices.push_back({pinIdx, PinType::Output});
-					}
-				}
+				continue;
+			}
+			if (depthStack.FindIndex(node.id) > pinDepth)
+			{
+				return true;
 			}
 		}
+		return false;
 	}
 
-	PinIdx ResolveHoveredPin(
-	    const ObjectPool<PinData>& pins, PinType type, const ImVector<PinIdx>& occludedPinIndices)
+	PinIdx ResolveHoveredPin(EditorContext& editor, PinType type)
 	{
 		float smallestDistance         = FLT_MAX;
 		i32 pinIdxWithSmallestDistance = NO_INDEX;
 
-		const float hoverRadiusSqr = gNodes->style.PinHoverRadius * gNodes->style.PinHoverRadius;
+		const float hoverRadius    = gNodes->style.PinHoverRadius;
+		const float hoverRadiusSqr = hoverRadius * hoverRadius;
+		const float gridRadius     = hoverRadius / editor.zoom;
+
+		// Only pins near the mouse are tested
+		const v2 mouseGridPos   = ScreenToGridPosition(editor, gNodes->mousePosition);
+		TArray<i32>& pinIndices = gNodes->gridQueryResults;
+		pinIndices.Clear(false);
+		const v2 extent{gridRadius, gridRadius};
+		editor.GetPinGrid(type).Query(Rect{mouseGridPos - extent, mouseGridPos + extent}, pinIndices);
 
-		for (i32 idx = 0; idx < pins.pool.Size(); ++idx)
+		const ObjectPool<PinData>& pins = editor.GetPinPool(type);
+		for (i32 idx : pinIndices)
 		{
 			if (!pins.inUse.IsSet(idx))
 			{
 				continue;
 			}
 
-			if (occludedPinIndices.contains({idx, type}))
-			{
-				continue;
-			}
-
 			const v2& pinPos        = pins.pool[idx].position;
 			const float distanceSqr = (pinPos - gNodes->mousePosition).LengthSquared();
 
@@ -1121,7 +1260,8 @@ namespace rift::Nodes
 			// pin-local value used here. This is no longer called in
 			// BeginPin/EndPin scope and the detected pin might have a different
 			// hover radius than what the user had when calling BeginPin/EndPin.
-			if (distanceSqr < hoverRadiusSqr && distanceSqr < smallestDistance)
+			if (distanceSqr < hoverRadiusSqr && distanceSqr < smallestDistance
+			    && !IsPinOccluded(editor, pins.pool[idx]))
 			{
 				smallestDistance           = distanceSqr;
 				pinIdxWithSmallestDistance = idx;
@@ -1162,9 +1302,10 @@ namespace rift::Nodes
 		return nodeIdOnTop;
 	}
 
-	OptionalIndex ResolveHoveredLink(const ObjectPool<LinkData>& links,
-	    const ObjectPool<PinData>& outputs, const ObjectPool<PinData>& inputs)
+	OptionalIndex ResolveHoveredLink(EditorContext& editor)
 	{
+		const ObjectPool<LinkData>& links = editor.links;
+
 		float smallestDistance = FLT_MAX;
 		OptionalIndex linkIdxWithSmallestDistance;
 
@@ -1176,16 +1317,23 @@ namespace rift::Nodes
 		// The latter is a requirement for link detaching with drag click to work, as both a
 		// link and pin are required to be hovered over for the feature to work.
 
-		for (i32 idx = 0; idx < links.pool.Size(); ++idx)
+		// Only links whose bounds are near the mouse are tested. Links using the hovered pin
+		// are included since their bounds contain the pin
+		const v2 mouseGridPos    = ScreenToGridPosition(editor, gNodes->mousePosition);
+		const float gridRadius   = gNodes->style.PinHoverRadius / editor.zoom;
+		const v2 extent{gridRadius, gridRadius};
+		TArray<i32>& linkIndices = gNodes->gridQueryResults;
+		linkIndices.Clear(false);
+		editor.linkGrid.Query(Rect{mouseGridPos - extent, mouseGridPos + extent}, linkIndices);
+
+		for (i32 idx : linkIndices)
 		{
 			if (!links.inUse.IsSet(idx))
 			{
 				continue;
 			}
 
-			const LinkData& link     = links.pool[idx];
-			const PinData& outputPin = outputs.pool[link.outputIdx];
-			const PinData& inputPin  = inputs.pool[link.inputIdx];
+			const LinkData& link = links.pool[idx];
 
 			// If there is a hovered pin links can only be considered hovered if they use that
 			// pin
@@ -1199,22 +1347,17 @@ namespace rift::Nodes
 				continue;
 			}
 
-			// TODO: the calculated CubicBeziers could be cached since we generate them again
-			// when rendering the links
-
-			const CubicBezier cubicBezier = MakeCubicBezier(outputPin.position, inputPin.position,
-			    PinType::Output, gNodes->style.linkLineSegmentsPerLength);
+			// The curve is cached and shared with link rendering
+			const LinkGeometry& geometry = GetLinkGeometry(editor, idx);
 
 			// The distance test
 			{
-				const Rect linkRect = GetContainingRectForCubicBezier(cubicBezier);
-
 				// First, do a simple bounding box test against the box containing the link
 				// to see whether calculating the distance to the link is worth doing.
-				if (linkRect.Contains(gNodes->mousePosition))
+				if (geometry.bounds.Contains(mouseGridPos))
 				{
-					const float distance = GetDistanceToCubicBezier(
-					    gNodes->mousePosition, cubicBezier, cubicBezier.numSegments);
+					const float distance =
+					    GetDistanceToLinkGeometry(mouseGridPos, geometry) * editor.zoom;
 
 					// TODO: gNodes->style.LinkHoverDistance could be also copied i32o
 					// LinkData, since we're not calling this function in the same scope as
@@ -1239,16 +1382,18 @@ namespace rift::Nodes
 		return {ImGui::GetItemRectMin(), ImGui::GetItemRectMax()};
 	}
 
-	v2 GetNodeTitleBarOrigin(const NodeData& node)
+	// Layout origins are in editor space. Layout style sizes are already zoomed
+	v2 GetNodeTitleBarOrigin(const EditorContext& editor, const NodeData& node)
 	{
-		return node.Origin + node.LayoutStyle.Padding;
+		return GridToEditorPosition(editor, node.Origin) + node.LayoutStyle.Padding;
 	}
 
-	v2 GetNodeContentOrigin(const NodeData& node)
+	v2 GetNodeContentOrigin(const EditorContext& editor, const NodeData& node)
 	{
 		const v2 titleBarHeight =
 		    v2(0.f, node.TitleBarContentRect.GetSize().y + 2.0f * node.LayoutStyle.Padding.y);
-		return node.Origin + titleBarHeight + node.LayoutStyle.Padding;
+		return GridToEditorPosition(editor, node.Origin) + titleBarHeight
+		     + node.LayoutStyle.Padding;
 	}
 
 	Rect GetNodeTitleRect(const NodeData& node)
@@ -1267,16 +1412,21 @@ namespace rift::Nodes
 		u32 lineColorPrim = gNodes->style.colors[ColorVar_GridLinePrimary].ToPackedABGR();
 		bool drawPrimary  = gNodes->style.Flags & StyleFlags_GridLinesPrimary;
 
-		for (float x = fmodf(offset.x, gNodes->style.GridSpacing); x < canvasSize.x;
-		     x += gNodes->style.GridSpacing)
+		// Skip lines when zoomed out so that they don't get too dense
+		float spacing = gNodes->style.GridSpacing * editor.zoom;
+		while (spacing < 8.f)
+		{
+			spacing *= 2.f;
+		}
+
+		for (float x = fmodf(offset.x, spacing); x < canvasSize.x; x += spacing)
 		{
 			gNodes->CanvasDrawList->AddLine(EditorToScreenPosition(v2(x, 0.0f)),
 			    EditorToScreenPosition(v2(x, canvasSize.y)),
 			    offset.x - x == 0.f && drawPrimary ? lineColorPrim : lineColor);
 		}
 
-		for (float y = fmodf(offset.y, gNodes->style.GridSpacing); y < canvasSize.y;
-		     y += gNodes->style.GridSpacing)
+		for (float y = fmodf(offset.y, spacing); y < canvasSize.y; y += spacing)
 		{
 			gNodes->CanvasDrawList->AddLine(EditorToScreenPosition(v2(0.0f, y)),
 			    EditorToScreenPosition(v2(canvasSize.x, y)),
@@ -1332,65 +1482,70 @@ namespace rift::Nodes
 		return offset;
 	}
 
-	void DrawPinShape(const v2& pinPos, const PinData& pin, const Color pinColor)
+	void DrawPinShape(const v2& pinPos, const PinData& pin, const Color pinColor, float scale)
 	{
 		static const i32 circleNumSegments = 8;
 
+		const Style& style             = gNodes->style;
+		const float circleRadius       = style.PinCircleRadius * scale;
+		const float quadSideLength     = style.PinQuadSideLength * scale;
+		const float triangleSideLength = style.PinTriangleSideLength * scale;
+		const float diamondSideLength  = style.PinDiamondSideLength * scale;
+		const float lineThickness      = style.PinLineThickness * scale;
+
 		switch (pin.Shape)
 		{
 			case PinShape_Circle: {
-				gNodes->CanvasDrawList->AddCircle(pinPos, gNodes->style.PinCircleRadius,
-				    pinColor.ToPackedABGR(), circleNumSegments, gNodes->style.PinLineThickness);
+				gNodes->CanvasDrawList->AddCircle(pinPos, circleRadius, pinColor.ToPackedABGR(),
+				    circleNumSegments, lineThickness);
 			}
 			break;
 			case PinShape_CircleFilled: {
-				gNodes->CanvasDrawList->AddCircleFilled(pinPos, gNodes->style.PinCircleRadius,
-				    pinColor.ToPackedABGR(), circleNumSegments);
+				gNodes->CanvasDrawList->AddCircleFilled(
+				    pinPos, circleRadius, pinColor.ToPackedABGR(), circleNumSegments);
 			}
 			break;
 			case PinShape_Quad: {
-				const QuadOffsets offset = CalculateQuadOffsets(gNodes->style.PinQuadSideLength);
+				const QuadOffsets offset = CalculateQuadOffsets(quadSideLength);
 				gNodes->CanvasDrawList->AddQuad(pinPos + offset.topLeft, pinPos + offset.bottomLeft,
 				    pinPos + offset.bottomRight, pinPos + offset.topRight, pinColor.ToPackedABGR(),
-				    gNodes->style.PinLineThickness);
+				    lineThickness);
 			}
 			break;
 			case PinShape_QuadFilled: {
-				const QuadOffsets offset = CalculateQuadOffsets(gNodes->style.PinQuadSideLength);
+				const QuadOffsets offset = CalculateQuadOffsets(quadSideLength);
 				gNodes->CanvasDrawList->AddQuadFilled(pinPos + offset.topLeft,
 				    pinPos + offset.bottomLeft, pinPos + offset.bottomRight,
 				    pinPos + offset.topRight, pinColor.ToPackedABGR());
 			}
 			break;
 			case PinShape_Triangle: {
-				const TriangleOffsets offset =
-				    CalculateTriangleOffsets(gNodes->style.PinTriangleSideLength);
+				const TriangleOffsets offset = CalculateTriangleOffsets(triangleSideLength);
 				gNodes->CanvasDrawList->AddTriangle(pinPos + offset.topLeft,
 				    pinPos + offset.bottomLeft, pinPos + offset.right, pinColor.ToPackedABGR(),
 				    // NOTE: for some weird reason, the line drawn by AddTriangle is
 				    // much thinner than the lines drawn by AddCircle or AddQuad.
 				    // Multiplying the line thickness by two seemed to solve the
 				    // problem at a few different thickness values.
-				    2.f * gNodes->style.PinLineThickness);
+				    2.f * lineThickness);
 			}
 			break;
 			case PinShape_TriangleFilled: {
-				const TriangleOffsets offset =
-				    CalculateTriangleOffsets(gNodes->style.PinTriangleSideLength);
+				const TriangleOffsets offset = CalculateTriangleOffsets(triangleSideLength);
 				gNodes->CanvasDrawList->AddTriangleFilled(pinPos + offset.topLeft,
 				    pinPos + offset.bottomLeft, pinPos + offset.right, pinColor.ToPackedABGR());
 			}
 			break;
 			case PinShape_Diamond: {
-				const float halfSide = 0.5f * gNodes->style.PinDiamondSideLength;
+				const float halfSide = 0.5f * diamondSideLength;
 				gNodes->CanvasDrawList->AddQuad(pinPos + v2{0.f, halfSide},
 				    pinPos + v2{halfSide, 0.f}, pinPos + v2{0.f, -halfSide},
 				    pinPos + v2{-halfSide, 0.f}, pinColor.ToPackedABGR(),
-				    gNodes->style.PinLineThickness);
+				    lineThickness);
 			}
 			break;
 			case PinShape_DiamondFilled: {
-				const float halfSide = 0.5f * gNodes->style.PinDiamondSideLength;
+				const float halfSide = 0.5f * diamondSideLength;
 				gNodes->CanvasDrawList->AddQuadFilled(pinPos + v2{0.f, halfSide},
 				    pinPos + v2{halfSide, 0.f}, pinPos + v2{0.f, -halfSide},
 				    pinPos + v2{-halfSide, 0.f}, pinColor.ToPackedABGR());
@@ -1405,7 +1560,12 @@ namespace rift::Nodes
 		PinData& pinData           = editor.GetPinData(pin);
 		const Rect& parentNodeRect = editor.nodes[pinData.parentNodeId].rect;
 
-		pinData.position = GetScreenSpacePinCoordinates(parentNodeRect, pin.type, pinData.rect);
+		pinData.position =
+		    GetScreenSpacePinCoordinates(parentNodeRect, pin.type, pinData.rect, editor.zoom);
+
+		pinData.gridPosition = ScreenToGridPosition(editor, pinData.position);
+		editor.GetPinGrid(pin.type).Update(
+		    pin.index, Rect{pinData.gridPosition, pinData.gridPosition});
 
 		Color pinColor = pinData.colorStyle.Background;
 		if (gNodes->HoveredPinIdx == pin)
@@ -1413,13 +1573,16 @@ namespace rift::Nodes
 			pinColor = pinData.colorStyle.Hovered;
 		}
 
-		DrawPinShape(pinData.position, pinData, pinColor);
+		if (editor.zoom >= gNodes->style.detailZoom)
+		{
+			DrawPinShape(pinData.position, pinData, pinColor, editor.zoom);
+		}
 	}
 
 	void DrawNode(EditorContext& editor, const AST::Id nodeId)
 	{
 		const NodeData& node = editor.nodes[nodeId];
-		ImGui::SetCursorPos(node.Origin + editor.panning);
+		ImGui::SetCursorPos(GridToEditorPosition(editor, node.Origin));
 
 		const bool nodeHovered = gNodes->hoveredNodeId == nodeId
 		                      && editor.clickInteraction.type != ClickInteractionType_BoxSelection;
@@ -1483,14 +1646,77 @@ namespace rift::Nodes
 		}
 	}
 
+	// Draws a kept node as a box with its title. Used when culled or zoomed out
+	void DrawSimplifiedNode(EditorContext& editor, const AST::Id nodeId)
+	{
+		const NodeData& node = editor.nodes[nodeId];
+		if (!RectsTouch(node.rect, gNodes->CanvasRectScreenSpace))
+		{
+			return;
+		}
+
+		const bool nodeHovered = gNodes->hoveredNodeId == nodeId
+		                      && editor.clickInteraction.type != ClickInteractionType_BoxSelection;
+
+		Color nodeBackground     = node.colorStyle.Background;
+		Color titlebarBackground = node.colorStyle.Titlebar;
+		if (editor.selectedNodeIds.Contains(nodeId))
+		{
+			nodeBackground     = node.colorStyle.BackgroundSelected;
+			titlebarBackground = node.colorStyle.TitlebarSelected;
+		}
+		else if (nodeHovered)
+		{
+			nodeBackground     = node.colorStyle.BackgroundHovered;
+			titlebarBackground = node.colorStyle.TitlebarHovered;
+		}
+
+		const float rounding = gNodes->style.NodeCornerRounding * editor.zoom;
+		gNodes->CanvasDrawList->AddRectFilled(
+		    node.rect.min, node.rect.max, nodeBackground.ToPackedABGR(), rounding);
+
+		// Font size is already scaled by the zoom
+		const float fontSize    = ImGui::GetFontSize();
+		const v2 padding        = gNodes->style.NodePadding * editor.zoom;
+		const float titleHeight = math::Min(fontSize + padding.y * 2.f, node.rect.GetSize().y);
+		const Rect titleRect{node.rect.min, v2{node.rect.max.x, node.rect.min.y + titleHeight}};
+		gNodes->CanvasDrawList->AddRectFilled(titleRect.min, titleRect.max,
+		    titlebarBackground.ToPackedABGR(), rounding, ImDrawFlags_RoundCornersTop);
+
+		// Skip text too small to be read
+		static constexpr float minFontSize = 6.f;
+		if (!node.simplifiedTitle.empty() && fontSize >= minFontSize)
+		{
+			const ImVec4 clipRect{titleRect.min.x, titleRect.min.y, titleRect.max.x,
+			    titleRect.max.y};
+			gNodes->CanvasDrawList->AddText(ImGui::GetFont(), fontSize, titleRect.min + padding,
+			    ImGui::GetColorU32(ImGuiCol_Text), node.simplifiedTitle.data(),
+			    node.simplifiedTitle.data() + node.simplifiedTitle.size(), 0.f, &clipRect);
+		}
+
+		if ((gNodes->style.Flags & StyleFlags_NodeOutline) != 0)
+		{
+			const float borderThickness = gNodes->style.NodeBorderThickness * editor.zoom;
+			if (borderThickness > 0.f)
+			{
+				gNodes->CanvasDrawList->AddRect(node.rect.min, node.rect.max,
+				    node.colorStyle.Outline.ToPackedABGR(), rounding, ImDrawFlags_RoundCornersAll,
+				    borderThickness);
+			}
+		}
+	}
+
 	void DrawLink(EditorContext& editor, const i32 linkIdx)
 	{
-		const LinkData& link    = editor.links.pool[linkIdx];
-		const PinData& startPin = editor.outputs.pool[link.outputIdx];
-		const PinData& endPin   = editor.inputs.pool[link.inputIdx];
+		const LinkData& link         = editor.links.pool[linkIdx];
+		const LinkGeometry& geometry = GetLinkGeometry(editor, linkIdx);
+		editor.linkGrid.Update(linkIdx, geometry.bounds);
 
-		const CubicBezier cubicBezier = MakeCubicBezier(startPin.position, endPin.position,
-		    PinType::Output, gNodes->style.linkLineSegmentsPerLength);
+		if (!RectsTouch(geometry.bounds, GetVisibleGridRect(editor)))
+		{
+			// Out of view. Hover and selection still use the cached geometry
+			return;
+		}
 
 		const bool linkHovered = gNodes->HoveredLinkIdx == linkIdx
 		                      && editor.clickInteraction.type != ClickInteractionType_BoxSelection;
@@ -1520,9 +1746,14 @@ namespace rift::Nodes
 			linkColor = link.colorStyle.Hovered;
 		}
 
-		gNodes->CanvasDrawList->AddBezierCubic(cubicBezier.p0, cubicBezier.p1, cubicBezier.p2,
-		    cubicBezier.p3, linkColor.ToPackedABGR(), gNodes->style.LinkThickness,
-		    cubicBezier.numSegments);
+		// Draw the cached tessellation instead of evaluating the curve again
+		const v2 offset = GridToScreenPosition(editor, v2::Zero());
+		for (const v2& point : geometry.points)
+		{
+			gNodes->CanvasDrawList->PathLineTo(point + offset);
+		}
+		gNodes->CanvasDrawList->PathStroke(linkColor.ToPackedABGR(), ImDrawFlags_None,
+		    math::Max(gNodes->style.LinkThickness * editor.zoom, 1.f));
 	}
 
 	void BeginPin(const i32 id, const PinType type, const PinShape shape, AST::Id nodeId)
@@ -1697,14 +1928,24 @@ namespace rift::Nodes
 		editor.panning        = pos;
 	}
 
+	float GetZoom()
+	{
+		const EditorContext& editor = GetEditorContext();
+		return editor.zoom;
+	}
+
+	void SetZoom(float zoom)
+	{
+		EditorContext& editor = GetEditorContext();
+		ZoomAround(editor, gNodes->CanvasRectScreenSpace.GetCenter(), zoom);
+	}
+
 	void MoveToNode(AST::Id nodeId, v2 offset)
 	{
 		EditorContext& editor = GetEditorContext();
 		NodeData& node        = editor.nodes.Get(nodeId);
 
-		editor.panning.x = -node.Origin.x;
-		editor.panning.y = -node.Origin.y;
-		editor.panning += offset;
+		editor.panning = offset - node.Origin * editor.zoom;
 	}
 
 	void SetImGuiContext(ImGuiContext* ctx)
@@ -1899,6 +2140,8 @@ namespace rift::Nodes
 			    ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoMove
 			        | ImGuiWindowFlags_NoScrollWithMouse);
 			gNodes->CanvasOriginScreenSpace = ImGui::GetCursorScreenPos();
+			// Node widgets scale with the zoom
+			ImGui::SetWindowFontScale(editor.zoom);
 
 			// NOTE: we have to fetch the canvas draw list *after* we call
 			// BeginChild(), otherwise the ImGui UI elements are going to be
@@ -1952,15 +2195,14 @@ namespace rift::Nodes
 		    && IsMouseInCanvas() && !editor.miniMap.IsHovered())
 		{
 			// Pins needs some special care. We need to check the depth stack to see which pins
-			// are being occluded by other nodes.
-			ResolveOccludedPins(editor, gNodes->occludedPinIndices);
-
-			gNodes->HoveredPinIdx =
-			    ResolveHoveredPin(editor.outputs, PinType::Output, gNodes->occludedPinIndices);
-			if (!gNodes->HoveredPinIdx)
+			// are being occluded by other nodes. Pins are not drawn below detail zoom.
+			if (editor.zoom >= gNodes->style.detailZoom)
 			{
-				gNodes->HoveredPinIdx =
-				    ResolveHoveredPin(editor.inputs, PinType::Input, gNodes->occludedPinIndices);
+				gNodes->HoveredPinIdx = ResolveHoveredPin(editor, PinType::Output);
+				if (!gNodes->HoveredPinIdx)
+				{
+					gNodes->HoveredPinIdx = ResolveHoveredPin(editor, PinType::Input);
+				}
 			}
 
 			if (!gNodes->HoveredPinIdx)
@@ -1974,15 +2216,17 @@ namespace rift::Nodes
 			// clicking and dragging, we need to have both a link and pin hovered.
 			if (IsNone(gNodes->hoveredNodeId))
 			{
-				gNodes->HoveredLinkIdx =
-				    ResolveHoveredLink(editor.links, editor.outputs, editor.inputs);
+				gNodes->HoveredLinkIdx = ResolveHoveredLink(editor);
 			}
 		}
 
 		for (AST::Id nodeId : editor.nodes)
 		{
-			DrawListActivateNodeBackground(nodeId);
-			DrawNode(editor, nodeId);
+			if (!editor.nodes[nodeId].culled)
+			{
+				DrawListActivateNodeBackground(nodeId);
+				DrawNode(editor, nodeId);
+			}
 		}
 
 		// In order to render the links underneath the nodes, we want to first select the bottom
@@ -1997,6 +2241,15 @@ namespace rift::Nodes
 			}
 		}
 
+		// Kept nodes have no draw channels. Draw them over the links
+		for (AST::Id nodeId : editor.nodes.depthOrder)
+		{
+			if (editor.nodes[nodeId].culled)
+			{
+				DrawSimplifiedNode(editor, nodeId);
+			}
+		}
+
 		// Render the click interaction UI elements (partial links, box selector) on top of
 		// everything else.
 
@@ -2047,25 +2300,42 @@ namespace rift::Nodes
 				    direction * ImGui::GetIO().DeltaTime * gNodes->io.AutoPanningSpeed;
 				editor.panning += editor.AutoPanningDelta;
 			}
+
+			const bool canZoom = editor.clickInteraction.type == ClickInteractionType_None
+			                  || editor.clickInteraction.type == ClickInteractionType_Panning;
+			if (gNodes->altMouseScrollDelta != 0.f && canZoom && IsMouseInCanvas()
+			    && !ImGui::IsAnyItemActive())
+			{
+				static constexpr float zoomStep = 1.1f;
+				const float zoom = editor.zoom * ImPow(zoomStep, gNodes->altMouseScrollDelta);
+				ZoomAround(editor, gNodes->mousePosition, zoom);
+			}
 		}
 		UpdateClickInteraction(editor);
 
 		// At this point, draw commands have been issued for all nodes (and pins). Update the
 		// node pool to detect unused node slots and remove those indices from the depth stack
 		// before sorting the node draw commands by depth.
-		for (AST::Id nodeId : editor.nodes)
-		{
-			auto& node = editor.nodes[nodeId];
-			node.inputs.clear();
-			node.outputs.clear();
-		}
 		editor.nodes.CacheInvalidIds();
 		editor.nodes.ClearDepthOrder();
+		for (AST::Id nodeId : editor.nodes.invalidIds)
+		{
+			editor.nodeGrid.Remove(i32(GetIdIndex(nodeId)));
+		}
 
 		ObjectPoolUpdate(editor.inputs);
 		ObjectPoolUpdate(editor.outputs);
 
-		DrawListSortChannelsByDepth(editor.nodes.depthOrder);
+		// Culled nodes have no draw channels
+		gNodes->submittedDepthOrder.Clear(false);
+		for (AST::Id nodeId : editor.nodes.depthOrder)
+		{
+			if (!editor.nodes[nodeId].culled)
+			{
+				gNodes->submittedDepthOrder.Add(nodeId);
+			}
+		}
+		DrawListSortChannelsByDepth(gNodes->submittedDepthOrder);
 
 		// After the links have been rendered, the link pool can be updated as well.
 		ObjectPoolUpdate(editor.links);
@@ -2092,6 +2362,10 @@ namespace rift::Nodes
 		gNodes->currentNodeId = nodeId;
 
 		NodeData& node = editor.nodes.GetOrAdd(nodeId);
+		node.id        = nodeId;
+		node.culled    = false;
+		node.inputs.clear();
+		node.outputs.clear();
 
 		node.colorStyle.Background         = gNodes->style.colors[ColorVar_NodeBackground];
 		node.colorStyle.BackgroundHovered  = gNodes->style.colors[ColorVar_NodeBackgroundHovered];
@@ -2100,14 +2374,14 @@ namespace rift::Nodes
 		node.colorStyle.Titlebar           = gNodes->style.colors[ColorVar_TitleBar];
 		node.colorStyle.TitlebarHovered    = gNodes->style.colors[ColorVar_TitleBarHovered];
 		node.colorStyle.TitlebarSelected   = gNodes->style.colors[ColorVar_TitleBarSelected];
-		node.LayoutStyle.CornerRounding    = gNodes->style.NodeCornerRounding;
-		node.LayoutStyle.Padding           = gNodes->style.NodePadding;
-		node.LayoutStyle.BorderThickness   = gNodes->style.NodeBorderThickness;
+		node.LayoutStyle.CornerRounding    = gNodes->style.NodeCornerRounding * editor.zoom;
+		node.LayoutStyle.Padding           = gNodes->style.NodePadding * editor.zoom;
+		node.LayoutStyle.BorderThickness   = gNodes->style.NodeBorderThickness * editor.zoom;
 
 		// ImGui::SetCursorPos sets the cursor position, local to the current widget
 		// (in this case, the child object started in BeginNodeEditor). Use
 		// ImGui::SetCursorScreenPos to set the screen space coordinates directly.
-		ImGui::SetCursorPos(GridToEditorPosition(editor, GetNodeTitleBarOrigin(node)));
+		ImGui::SetCursorPos(GetNodeTitleBarOrigin(editor, node));
 
 		DrawListAddNode(nodeId);
 		DrawListActivateCurrentNodeForeground();
@@ -2130,9 +2404,11 @@ namespace rift::Nodes
 		NodeData& node = editor.nodes[gNodes->currentNodeId];
 		node.rect      = GetItemRect();
 		node.rect.Expand(node.LayoutStyle.Padding);
+		node.gridSize = node.rect.GetSize() / editor.zoom;
 
 		editor.gridContentBounds.Merge(node.Origin);
-		editor.gridContentBounds.Merge(node.Origin + node.rect.GetSize());
+		editor.gridContentBounds.Merge(node.Origin + node.gridSize);
+		editor.nodeGrid.Update(i32(GetIdIndex(node.id)), ScreenToGridRect(editor, node.rect));
 
 		if (node.rect.Contains(gNodes->mousePosition))
 		{
@@ -2140,6 +2416,77 @@ namespace rift::Nodes
 		}
 	}
 
+	bool IsNodeVisible(AST::Id nodeId)
+	{
+		EditorContext& editor = GetEditorContext();
+		if (!editor.nodes.lastFrameIds.ContainsSorted(nodeId))
+		{
+			// The size of the node is unknown until it is laid out
+			return true;
+		}
+		const NodeData& node = editor.nodes[nodeId];
+		const Rect gridRect{node.Origin, node.Origin + node.gridSize};
+		return RectsTouch(gridRect, GetVisibleGridRect(editor));
+	}
+
+	bool ShouldLayoutNode(AST::Id nodeId)
+	{
+		EditorContext& editor = GetEditorContext();
+		if (!editor.nodes.lastFrameIds.ContainsSorted(nodeId)
+		    || editor.nodes[nodeId].gridSize.x <= 0.f)
+		{
+			return true;
+		}
+		return editor.zoom >= gNodes->style.detailZoom && IsNodeVisible(nodeId);
+	}
+
+	void KeepNode(AST::Id nodeId, StringView title)
+	{
+		assert(gNodes->currentScope == Scope::Editor);
+		EditorContext& editor = GetEditorContext();
+
+		NodeData& node       = editor.nodes.GetOrAdd(nodeId);
+		node.id              = nodeId;
+		node.culled          = true;
+		node.simplifiedTitle = title;
+
+		// Keep the last layout. Only its screen transform can change (by panning, zoom or moving)
+		const v2 lastMin   = node.rect.min;
+		const v2 lastSize  = node.rect.GetSize();
+		const v2 newMin    = GridToScreenPosition(editor, node.Origin);
+		const float scale  = lastSize.x > 0.f ? node.gridSize.x * editor.zoom / lastSize.x : 1.f;
+		const auto keepPos = [lastMin, newMin, scale](const v2& pos) {
+			return newMin + (pos - lastMin) * scale;
+		};
+		node.rect = Rect{newMin, newMin + node.gridSize * editor.zoom};
+
+		editor.gridContentBounds.Merge(node.Origin);
+		editor.gridContentBounds.Merge(node.Origin + node.gridSize);
+		editor.nodeGrid.Update(
+		    i32(GetIdIndex(nodeId)), Rect{node.Origin, node.Origin + node.gridSize});
+
+		if (node.rect.Contains(gNodes->mousePosition))
+		{
+			gNodes->nodeIdsOverlappingWithMouse.push_back(nodeId);
+		}
+
+		// Pins stay alive so links to this node keep their endpoints
+		for (i32 pinIndex : node.inputs)
+		{
+			editor.inputs.inUse.FillBit(pinIndex);
+			PinData& pin = editor.inputs.pool[pinIndex];
+			pin.rect     = Rect{keepPos(pin.rect.min), keepPos(pin.rect.max)};
+			pin.position = GridToScreenPosition(editor, pin.gridPosition);
+		}
+		for (i32 pinIndex : node.outputs)
+		{
+			editor.outputs.inUse.FillBit(pinIndex);
+			PinData& pin = editor.outputs.pool[pinIndex];
+			pin.rect     = Rect{keepPos(pin.rect.min), keepPos(pin.rect.max)};
+			pin.position = GridToScreenPosition(editor, pin.gridPosition);
+		}
+	}
+
 	v2 GetNodeDimensions(AST::Id nodeId)
 	{
 		assert(!IsNone(nodeId));
@@ -2166,7 +2513,7 @@ namespace rift::Nodes
 		Rect nodeTitleRect = GetNodeTitleRect(node);
 		ImGui::ItemAdd({nodeTitleRect.min, nodeTitleRect.max}, ImGui::GetID("title_bar"));
 
-		ImGui::SetCursorPos(GridToEditorPosition(editor, GetNodeContentOrigin(node)));
+		ImGui::SetCursorPos(GetNodeContentOrigin(editor, node));
 	}
 
 	void BeginInput(const i32 id, const PinShape shape)
@@ -2230,6 +2577,17 @@ namespace rift::Nodes
 		}
 	}
 
+	bool IsLinkVisible(Id id)
+	{
+		EditorContext& editor = GetEditorContext();
+		const i32 linkIdx     = editor.links.idMap.GetInt(static_cast<ImGuiID>(id), -1);
+		if (linkIdx == -1 || !editor.linkGeometries.IsValidIndex(linkIdx))
+		{
+			return true;
+		}
+		return RectsTouch(editor.linkGeometries[linkIdx].bounds, GetVisibleGridRect(editor));
+	}
+
 	void PushStyleColor(const ColorVar item, Color color)
 	{
 		gNodes->ColorModifierStack.push_back(ColElement(item, gNodes->style.colors[item]));
@@ -87,57 +87,55 @@ namespace rift::Nodes
 		scaling            = miniMapScaling;
 	}
 
-	void MiniMap::DrawNode(EditorContext& editor, const AST::Id nodeId)
+	bool SameVector(const v2& one, const v2& other)
 	{
-		const NodeData& node = editor.nodes[nodeId];
-
-		const Rect nodeRect{ScreenToMiniMapPosition(editor, node.rect.min),
-		    ScreenToMiniMapPosition(editor, node.rect.max)};
+		return one.x == other.x && one.y == other.y;
+	}
 
-		// Round to near whole pixel value for corner-rounding to prevent visual glitches
-		const float miniMapNodeRounding = math::Floor(node.LayoutStyle.CornerRounding * scaling);
+	// Hash of the style values used by the cached draw data
+	u32 GetMiniMapStyleHash()
+	{
+		const Style& style = gNodes->style;
+		const u32 values[]{style.colors[ColorVar_MiniMapNodeBackground].ToPackedABGR(),
+		    style.colors[ColorVar_MiniMapNodeOutline].ToPackedABGR(),
+		    style.colors[ColorVar_MiniMapLink].ToPackedABGR()};
+		const float sizes[]{style.NodeCornerRounding, style.LinkThickness,
+		    style.linkLineSegmentsPerLength};
+		return ImHashData(sizes, sizeof(sizes), ImHashData(values, sizeof(values)));
+	}
 
-		Color miniMapNodeBackground;
-		if (editor.clickInteraction.type == ClickInteractionType_None
-		    && ImGui::IsMouseHoveringRect(nodeRect.min, nodeRect.max))
-		{
-			miniMapNodeBackground = gNodes->style.colors[ColorVar_MiniMapNodeBackgroundHovered];
 
-			// Run user callback when hovering a mini-map node
-			if (nodeHoveringCallback)
-			{
-				nodeHoveringCallback(nodeId, nodeHoveringCallbackUserData);
-			}
-		}
-		else if (editor.selectedNodeIds.Contains(nodeId))
-		{
-			miniMapNodeBackground = gNodes->style.colors[ColorVar_MiniMapNodeBackgroundSelected];
-		}
-		else
+	MiniMap::~MiniMap()
+	{
+		if (cachedDrawList)
 		{
-			miniMapNodeBackground = gNodes->style.colors[ColorVar_MiniMapNodeBackground];
+			IM_DELETE(cachedDrawList);
 		}
+	}
+
+	void MiniMap::DrawNode(ImDrawList* drawList, const v2& offset, EditorContext& editor,
+	    const AST::Id nodeId, const Color& background)
+	{
+		const NodeData& node = editor.nodes[nodeId];
+
+		const v2 min = (node.Origin - editor.gridContentBounds.min) * scaling + offset;
+		const Rect nodeRect{min, min + node.gridSize * scaling};
+
+		// Round to near whole pixel value for corner-rounding to prevent visual glitches
+		const float miniMapNodeRounding = math::Floor(gNodes->style.NodeCornerRounding * scaling);
 
 		const Color miniMapNodeOutline = gNodes->style.colors[ColorVar_MiniMapNodeOutline];
 
-		gNodes->CanvasDrawList->AddRectFilled(
-		    nodeRect.min, nodeRect.max, miniMapNodeBackground.ToPackedABGR(), miniMapNodeRounding);
+		drawList->AddRectFilled(
+		    nodeRect.min, nodeRect.max, background.ToPackedABGR(), miniMapNodeRounding);
 
-		gNodes->CanvasDrawList->AddRect(
+		drawList->AddRect(
 		    nodeRect.min, nodeRect.max, miniMapNodeOutline.ToPackedABGR(), miniMapNodeRounding);
 	}
 
-	void MiniMap::DrawLink(EditorContext& editor, const i32 linkIdx)
+	void MiniMap::DrawLink(ImDrawList* drawList, const v2& offset, EditorContext& editor,
+	    const i32 linkIdx, const Color& color)
 	{
-		const LinkData& link      = editor.links.pool[linkIdx];
-		const PinData& outputData = editor.outputs.pool[link.outputIdx];
-		const PinData& inputData  = editor.inputs.pool[link.inputIdx];
-
-		const v2 outputPosition       = ScreenToMiniMapPosition(editor, outputData.position);
-		const v2 inputPosition        = ScreenToMiniMapPosition(editor, inputData.position);
-		const CubicBezier cubicBezier = MakeCubicBezier(outputPosition, inputPosition,
-		    PinType::Output, gNodes->style.linkLineSegmentsPerLength / scaling);
-
 		// It's possible for a link to be deleted in begin_link_i32eraction. A user
 		// may detach a link, resulting in the link wire snapping to the mouse
 		// position.
@@ -148,14 +146,167 @@ namespace rift::Nodes
 			return;
 		}
 
-		const Color linkColor =
-		    gNodes->style
-		        .colors[editor.selectedLinkIndices.contains(linkIdx) ? ColorVar_MiniMapLinkSelected
-		                                                             : ColorVar_MiniMapLink];
+		const LinkGeometry& geometry  = GetLinkGeometry(editor, linkIdx);
+		const v2 gridMin              = editor.gridContentBounds.min;
+		const v2 outputPosition       = (geometry.start - gridMin) * scaling + offset;
+		const v2 inputPosition        = (geometry.end - gridMin) * scaling + offset;
+		const CubicBezier cubicBezier = MakeCubicBezier(outputPosition, inputPosition,
+		    PinType::Output, gNodes->style.linkLineSegmentsPerLength / scaling);
 
-		gNodes->CanvasDrawList->AddBezierCubic(cubicBezier.p0, cubicBezier.p1, cubicBezier.p2,
-		    cubicBezier.p3, linkColor.ToPackedABGR(), gNodes->style.LinkThickness * scaling,
-		    cubicBezier.numSegments);
+		drawList->AddBezierCubic(cubicBezier.p0, cubicBezier.p1, cubicBezier.p2, cubicBezier.p3,
+		    color.ToPackedABGR(), gNodes->style.LinkThickness * scaling, cubicBezier.numSegments);
+	}
+
+	bool MiniMap::UpdateCachedState(EditorContext& editor)
+	{
+		bool changed = !cachedDrawList || cachedScaling != scaling
+		            || !SameVector(cachedGridMin, editor.gridContentBounds.min)
+		            || !SameVector(cachedContentSize, contentScreenSpace.GetSize());
+		const u32 styleHash = GetMiniMapStyleHash();
+		changed |= cachedStyleHash != styleHash;
+
+		cachedScaling     = scaling;
+		cachedGridMin     = editor.gridContentBounds.min;
+		cachedContentSize = contentScreenSpace.GetSize();
+		cachedStyleHash   = styleHash;
+
+		// Compare and update the grid-space state in one pass
+		i32 nodeCount = 0;
+		for (AST::Id nodeId : editor.nodes)
+		{
+			const NodeData& node = editor.nodes[nodeId];
+			const Rect rect{node.Origin, node.Origin + node.gridSize};
+			if (nodeCount < cachedNodeIds.Size())
+			{
+				const Rect& cachedRect = cachedNodeRects[nodeCount];
+				if (cachedNodeIds[nodeCount] != nodeId || !SameVector(cachedRect.min, rect.min)
+				    || !SameVector(cachedRect.max, rect.max))
+				{
+					changed                    = true;
+					cachedNodeIds[nodeCount]   = nodeId;
+					cachedNodeRects[nodeCount] = rect;
+				}
+			}
+			else
+			{
+				changed = true;
+				cachedNodeIds.Add(nodeId);
+				cachedNodeRects.Add(rect);
+			}
+			++nodeCount;
+		}
+		if (nodeCount != cachedNodeIds.Size())
+		{
+			changed = true;
+			cachedNodeIds.Resize(nodeCount);
+			cachedNodeRects.Resize(nodeCount);
+		}
+
+		i32 endpointCount = 0;
+		for (i32 linkIdx = 0; linkIdx < editor.links.pool.Size(); ++linkIdx)
+		{
+			if (!editor.links.inUse.IsSet(linkIdx) || gNodes->DeletedLinkIdx == linkIdx)
+			{
+				continue;
+			}
+			const LinkGeometry& geometry = GetLinkGeometry(editor, linkIdx);
+			for (const v2& point : {geometry.start, geometry.end})
+			{
+				if (endpointCount < cachedLinkEndpoints.Size())
+				{
+					if (!SameVector(cachedLinkEndpoints[endpointCount], point))
+					{
+						changed                            = true;
+						cachedLinkEndpoints[endpointCount] = point;
+					}
+				}
+				else
+				{
+					changed = true;
+					cachedLinkEndpoints.Add(point);
+				}
+				++endpointCount;
+			}
+		}
+		if (endpointCount != cachedLinkEndpoints.Size())
+		{
+			changed = true;
+			cachedLinkEndpoints.Resize(endpointCount);
+		}
+		return changed;
+	}
+
+	void MiniMap::RebuildCache(EditorContext& editor)
+	{
+		if (!cachedDrawList)
+		{
+			cachedDrawList = IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData());
+		}
+		cachedDrawList->_ResetForNewFrame();
+		cachedDrawList->PushClipRectFullScreen();
+		cachedDrawList->PushTextureID(ImGui::GetIO().Fonts->TexID);
+
+		// Draw links first so they appear under nodes
+		const Color linkColor = gNodes->style.colors[ColorVar_MiniMapLink];
+		for (i32 linkIdx = 0; linkIdx < editor.links.pool.Size(); ++linkIdx)
+		{
+			if (editor.links.inUse.IsSet(linkIdx))
+			{
+				DrawLink(cachedDrawList, v2::Zero(), editor, linkIdx, linkColor);
+			}
+		}
+
+		const Color nodeBackground = gNodes->style.colors[ColorVar_MiniMapNodeBackground];
+		for (AST::Id nodeId : editor.nodes)
+		{
+			DrawNode(cachedDrawList, v2::Zero(), editor, nodeId, nodeBackground);
+		}
+	}
+
+	void MiniMap::DrawCache()
+	{
+		ImDrawList* drawList = gNodes->CanvasDrawList;
+		const v2 offset      = contentScreenSpace.min;
+
+		// All commands share texture and clip rect. They only split when the vertex offset changes
+		const ImVector<ImDrawCmd>& commands = cachedDrawList->CmdBuffer;
+		for (i32 i = 0; i < commands.Size; ++i)
+		{
+			const ImDrawCmd& command = commands[i];
+			if (command.ElemCount == 0)
+			{
+				continue;
+			}
+			const i32 vtxBegin = i32(command.VtxOffset);
+			i32 vtxEnd         = cachedDrawList->VtxBuffer.Size;
+			for (i32 j = i + 1; j < commands.Size; ++j)
+			{
+				if (commands[j].VtxOffset != command.VtxOffset)
+				{
+					vtxEnd = i32(commands[j].VtxOffset);
+					break;
+				}
+			}
+
+			const i32 vtxCount = vtxEnd - vtxBegin;
+			drawList->PrimReserve(i32(command.ElemCount), vtxCount);
+			const ImDrawIdx baseIdx = ImDrawIdx(drawList->_VtxCurrentIdx);
+			for (i32 v = 0; v < vtxCount; ++v)
+			{
+				ImDrawVert vertex = cachedDrawList->VtxBuffer[vtxBegin + v];
+				vertex.pos.x += offset.x;
+				vertex.pos.y += offset.y;
+				drawList->_VtxWritePtr[v] = vertex;
+			}
+			const ImDrawIdx* indices = cachedDrawList->IdxBuffer.Data + command.IdxOffset;
+			for (u32 idx = 0; idx < command.ElemCount; ++idx)
+			{
+				drawList->_IdxWritePtr[idx] = ImDrawIdx(baseIdx + indices[idx]);
+			}
+			drawList->_VtxWritePtr += vtxCount;
+			drawList->_IdxWritePtr += command.ElemCount;
+			drawList->_VtxCurrentIdx += u32(vtxCount);
+		}
 	}
 
 	void MiniMap::Update()
@@ -190,18 +341,53 @@ namespace rift::Nodes
 		gNodes->CanvasDrawList->PushClipRect(
 		    miniMapRect.min, miniMapRect.max, true /* i32ersect with editor clip-rect */);
 
-		// Draw links first so they appear under nodes, and we can use the same draw channel
-		for (i32 linkIdx = 0; linkIdx < editor.links.pool.Size(); ++linkIdx)
+		if (UpdateCachedState(editor))
+		{
+			RebuildCache(editor);
+		}
+		DrawCache();
+
+		// Selected and hovered elements are drawn again on top of the cached draw data
+		const v2 offset = contentScreenSpace.min;
+		for (i32 linkIdx : editor.selectedLinkIndices)
 		{
 			if (editor.links.inUse.IsSet(linkIdx))
 			{
-				DrawLink(editor, linkIdx);
+				DrawLink(gNodes->CanvasDrawList, offset, editor, linkIdx,
+				    gNodes->style.colors[ColorVar_MiniMapLinkSelected]);
 			}
 		}
-
-		for (AST::Id nodeId : editor.nodes)
+		for (AST::Id nodeId : editor.selectedNodeIds)
 		{
-			DrawNode(editor, nodeId);
+			if (editor.nodes.Contains(nodeId))
+			{
+				DrawNode(gNodes->CanvasDrawList, offset, editor, nodeId,
+				    gNodes->style.colors[ColorVar_MiniMapNodeBackgroundSelected]);
+			}
+		}
+		if (editor.clickInteraction.type == ClickInteractionType_None && IsHovered())
+		{
+			const v2 gridPos         = MiniMapToGridPosition(editor, ImGui::GetMousePos());
+			TArray<i32>& nodeIndices = gNodes->gridQueryResults;
+			nodeIndices.Clear(false);
+			editor.nodeGrid.Query(Rect{gridPos, gridPos}, nodeIndices);
+			for (i32 nodeIndex : nodeIndices)
+			{
+				const NodeData& node = editor.nodes.data[nodeIndex];
+				const Rect gridRect{node.Origin, node.Origin + node.gridSize};
+				if (!editor.nodes.Contains(node.id) || !gridRect.Contains(gridPos))
+				{
+					continue;
+				}
+				DrawNode(gNodes->CanvasDrawList, offset, editor, node.id,
+				    gNodes->style.colors[ColorVar_MiniMapNodeBackgroundHovered]);
+
+				// Run user callback when hovering a mini-map node
+				if (nodeHoveringCallback)
+				{
+					nodeHoveringCallback(node.id, nodeHoveringCallbackUserData);
+				}
+			}
 		}
 
 		// Draw editor canvas rect inside mini-map
@@ -229,7 +415,7 @@ namespace rift::Nodes
 		{
 			v2 target      = MiniMapToGridPosition(editor, ImGui::GetMousePos());
 			v2 center      = gNodes->CanvasRectScreenSpace.GetSize() * 0.5f;
-			editor.panning = ImFloor(center - target);
+			editor.panning = ImFloor(center - target * editor.zoom);
 		}
 
 		// Reset callback info after use
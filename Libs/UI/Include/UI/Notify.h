@@ -27,6 +27,8 @@ namespace rift::UI
 	};
 
 	void AddNotification(Toast toast);
+	// @return true while notifications are shown and need to be animated
+	bool HasNotifications();
 
 	void DrawNotifications();
 }    // namespace rift::UI
@@ -18,6 +18,15 @@ namespace rift::UI
 	void PreFrame();
 	void Render();
 
+	/**
+	 * Sleeps until a window event is received or timeout (in seconds) passes.
+	 * @return true if an event was received before the timeout
+	 */
+	bool WaitEvents(float timeout);
+	// Wakes up a thread waiting on WaitEvents. Can be called from any thread
+	void WakeUp();
+	bool IsFocused();
+
 	void Close();
 	bool WantsToClose();
 
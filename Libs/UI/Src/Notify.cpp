@@ -143,6 +143,11 @@ namespace rift::UI
 		gNotifications.Add(Notification{toast});
 	}
 
+	bool HasNotifications()
+	{
+		return !gNotifications.IsEmpty();
+	}
+
 	void DrawNotifications()
 	{
 		ImGui::PushStyleVar(ImGuiStyleVar_WindowRounding, 2.f);
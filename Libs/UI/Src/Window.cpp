@@ -154,6 +154,24 @@ namespace rift::UI
 		glfwSwapBuffers(gWindow);
 	}
 
+	bool WaitEvents(float timeout)
+	{
+		ZoneScoped;
+		const double start = glfwGetTime();
+		glfwWaitEventsTimeout(timeout);
+		return glfwGetTime() - start < timeout;
+	}
+
+	void WakeUp()
+	{
+		glfwPostEmptyEvent();
+	}
+
+	bool IsFocused()
+	{
+		return glfwGetWindowAttrib(gWindow, GLFW_FOCUSED) != 0;
+	}
+
 	void Close()
 	{
 		glfwSetWindowShouldClose(gWindow, true);
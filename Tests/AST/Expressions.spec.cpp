@@ -1,8 +1,15 @@
 // Copyright 2015-2023 Piperift - All rights reserved
 
+#include <AST/Components/Tags/CChanged.h>
+#include <AST/Statics/SLoadQueue.h>
+#include <AST/Systems/TypeSystem.h>
 #include <AST/Tree.h>
+#include <AST/Utils/Compaction.h>
 #include <AST/Utils/Expressions.h>
+#include <AST/Utils/References.h>
+#include <AST/Utils/TransactionUtils.h>
 #include <AST/Utils/TypeUtils.h>
+#include <ASTModule.h>
 #include <bandit/bandit.h>
 
 
@@ -30,5 +37,148 @@ go_bandit([]() {
 			AssertThat(ast.Get<AST::CExprInputs>(id2).linkedOutputs.Size(),
 			    Equals(ast.Get<AST::CExprInputs>(id2).pinIds.Size()));
 		});
+
+		it("Prevents loops", [&]() {
+			AST::Tree ast;
+
+			AST::Id a = AST::AddBinaryOperator({ast, AST::NoId}, AST::BinaryOperatorType::Add);
+			AST::Id b = AST::AddBinaryOperator({ast, AST::NoId}, AST::BinaryOperatorType::Add);
+			AST::Id c = AST::AddBinaryOperator({ast, AST::NoId}, AST::BinaryOperatorType::Add);
+			auto inputOf = [&ast](AST::Id id) {
+				return AST::GetExprInputFromPin(ast, ast.Get<AST::CExprInputs>(id).pinIds[0]);
+			};
+
+			AssertThat(AST::TryConnectExpr(ast, AST::GetExprOutputFromPin(ast, a), inputOf(b)),
+			    Equals(true));
+			AssertThat(AST::TryConnectExpr(ast, AST::GetExprOutputFromPin(ast, b), inputOf(c)),
+			    Equals(true));
+			AssertThat(AST::CanConnectExpr(ast, AST::GetExprOutputFromPin(ast, c), inputOf(a)),
+			    Equals(false));
+
+			AST::DisconnectExpr(ast, inputOf(b));
+			AssertThat(AST::CanConnectExpr(ast, AST::GetExprOutputFromPin(ast, c), inputOf(a)),
+			    Equals(true));
+		});
+
+		it("Can undo links", [&]() {
+			AST::Tree ast;
+
+			AST::Id a = AST::AddBinaryOperator({ast, AST::NoId}, AST::BinaryOperatorType::Add);
+			AST::Id b = AST::AddBinaryOperator({ast, AST::NoId}, AST::BinaryOperatorType::Add);
+			auto isLinked = [&ast, a, b]() {
+				return ast.Get<AST::CExprInputs>(b).linkedOutputs[0].nodeId == a;
+			};
+			{
+				ScopedChange(ast, b);
+				AST::TryConnectExpr(ast, AST::GetExprOutputFromPin(ast, a),
+				    AST::GetExprInputFromPin(ast, ast.Get<AST::CExprInputs>(b).pinIds[0]));
+			}
+			AssertThat(isLinked(), Equals(true));
+
+			AssertThat(AST::Transactions::Undo(ast), Equals(true));
+			AssertThat(isLinked(), Equals(false));
+			AssertThat(AST::Transactions::CanUndo(ast), Equals(false));
+
+			AssertThat(AST::Transactions::Redo(ast), Equals(true));
+			AssertThat(isLinked(), Equals(true));
+			AssertThat(AST::Transactions::CanRedo(ast), Equals(false));
+		});
+
+		it("Can undo created entities", [&]() {
+			AST::Tree ast;
+
+			AST::Id typeId = AST::CreateType(ast, ASTModule::classType, "Type");
+			auto getFunctions = [&ast, typeId]() {
+				p::TArray<AST::Id> functionIds;
+				p::GetChildren(ast, typeId, functionIds);
+				return functionIds;
+			};
+			{
+				ScopedChange(ast, typeId);
+				AST::AddFunction({ast, typeId}, "Function");
+			}
+			AssertThat(getFunctions().Size(), Equals(1));
+
+			AssertThat(AST::Transactions::Undo(ast), Equals(true));
+			AssertThat(getFunctions().Size(), Equals(0));
+			AssertThat(p::FindAllIdsWith<AST::CDeclFunction>(ast).Size(), Equals(0));
+
+			AssertThat(AST::Transactions::Redo(ast), Equals(true));
+			p::TArray<AST::Id> functionIds = getFunctions();
+			AssertThat(functionIds.Size(), Equals(1));
+			AssertThat(ast.Has<AST::CDeclFunction>(functionIds[0]), Equals(true));
+		});
+
+		it("Keeps links when compacting", [&]() {
+			AST::Tree ast;
+
+			AST::Id c = AST::AddBinaryOperator({ast, AST::NoId}, AST::BinaryOperatorType::Add);
+			AST::Id a = AST::AddBinaryOperator({ast, AST::NoId}, AST::BinaryOperatorType::Add);
+			AST::Id b = AST::AddBinaryOperator({ast, AST::NoId}, AST::BinaryOperatorType::Add);
+			AST::TryConnectExpr(ast, AST::GetExprOutputFromPin(ast, a),
+			    AST::GetExprInputFromPin(ast, ast.Get<AST::CExprInputs>(b).pinIds[0]));
+			p::Remove(ast, c, true);
+
+			AssertThat(AST::CompactTree(ast), Equals(true));
+			p::TArray<AST::Id> nodeIds = p::FindAllIdsWith<AST::CExprBinaryOperator>(ast);
+			AssertThat(nodeIds.Size(), Equals(2));
+			const AST::ExprOutput& link = ast.Get<AST::CExprInputs>(nodeIds[1]).linkedOutputs[0];
+			AssertThat(link.nodeId, Equals(nodeIds[0]));
+			AssertThat(ast.Get<AST::CExprOutputs>(nodeIds[0]).pinIds.Contains(link.pinId),
+			    Equals(true));
+		});
+
+		it("Keeps pending loads when compacting", [&]() {
+			AST::Tree ast;
+
+			p::Remove(ast, AST::AddBinaryOperator({ast, AST::NoId}, AST::BinaryOperatorType::Add),
+			    true);
+			AST::Id typeId = AST::CreateType(ast, ASTModule::classType, "Type");
+			ast.SetStatic<AST::SLoadQueue>();
+			ast.GetStatic<AST::SLoadQueue>().pendingSyncLoad.Add(typeId);
+
+			AssertThat(AST::CompactTree(ast), Equals(true));
+			const auto& loadQueue = ast.GetStatic<AST::SLoadQueue>();
+			AssertThat(loadQueue.pendingSyncLoad.Size(), Equals(1));
+			AssertThat(ast.Has<AST::CDeclType>(loadQueue.pendingSyncLoad[0]), Equals(true));
+		});
+
+		it("Propagates types from a stable producer into a new consumer", [&]() {
+			AST::Tree ast;
+
+			AST::Id typeId = AST::CreateType(ast, ASTModule::classType, "Type");
+			AST::Id a      = AST::AddBinaryOperator({ast, typeId}, AST::BinaryOperatorType::Add);
+			AST::Id b      = AST::AddUnaryOperator({ast, typeId}, AST::UnaryOperatorType::Not);
+			// The producer already has a type and doesn't change
+			const AST::Id floatId = ast.GetNativeTypes().floatId;
+			ast.Add(a, AST::CExprTypeId{.id = floatId});
+
+			AST::TryConnectExpr(ast, AST::GetExprOutputFromPin(ast, a),
+			    AST::GetExprInputFromPin(ast, ast.Get<AST::CExprInputs>(b).pinIds[0]));
+			ast.Add<AST::CChanged>(typeId);
+			AST::TypeSystem::PropagateExpressionTypes(ast);
+
+			AssertThat(ast.Has<AST::CExprTypeId>(b), Equals(true));
+			AssertThat(ast.Get<AST::CExprTypeId>(b).id, Equals(floatId));
+		});
+
+		it("Can find references", [&]() {
+			AST::Tree ast;
+
+			AST::Id functionId = AST::AddFunction({ast, AST::NoId}, "Function");
+			AST::Id callId     = AST::AddCall({ast, AST::NoId}, functionId);
+
+			p::TArray<AST::Id> references;
+			AST::FindReferences(ast, functionId, references);
+			AssertThat(references.Size(), Equals(1));
+			AssertThat(references[0], Equals(callId));
+
+			AST::Id otherCallId = AST::AddCall({ast, AST::NoId}, functionId);
+			ast.Destroy(callId);
+			references.Clear();
+			AST::FindReferences(ast, functionId, references);
+			AssertThat(references.Size(), Equals(1));
+			AssertThat(references[0], Equals(otherCallId));
+		});
 	});
 });
@@ -0,0 +1,100 @@
+// Copyright 2015-2023 Piperift - All rights reserved
+
+#include <AST/Statics/SHierarchy.h>
+#include <AST/Tree.h>
+#include <AST/Utils/Hierarchy.h>
+#include <AST/Utils/TypeUtils.h>
+#include <ASTModule.h>
+#include <bandit/bandit.h>
+
+
+using namespace snowhouse;
+using namespace bandit;
+using namespace rift;
+
+
+namespace
+{
+	// @return true if the flat hierarchy matches one rebuilt from scratch
+	bool MatchesRebuild(AST::Tree& ast)
+	{
+		p::TArray<AST::Id> ids;
+		ids.Append(AST::GetFlatHierarchy(ast).ids);
+		p::TArray<p::i32> subtreeSizes;
+		subtreeSizes.Append(AST::GetFlatHierarchy(ast).subtreeSizes);
+
+		AST::InvalidateFlatHierarchy(ast);
+		const AST::SHierarchy& rebuilt = AST::GetFlatHierarchy(ast);
+		if (ids.Size() != rebuilt.ids.Size())
+		{
+			return false;
+		}
+		for (p::i32 i = 0; i < ids.Size(); ++i)
+		{
+			if (ids[i] != rebuilt.ids[i] || subtreeSizes[i] != rebuilt.subtreeSizes[i])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}    // namespace
+
+
+go_bandit([]() {
+	describe("AST.Hierarchy", []() {
+		it("Adds children of nested ids once", [&]() {
+			AST::Tree ast;
+			AST::Id typeId     = AST::CreateType(ast, ASTModule::classType, "Type");
+			AST::Id functionId = AST::AddFunction({ast, typeId}, "Function");
+			AST::AddCall({ast, functionId}, functionId);
+			AST::AddIf({ast, functionId});
+
+			p::TArray<AST::Id> childIds;
+			AST::GetAllChildren(ast, typeId, childIds);
+			const p::i32 count = childIds.Size();
+			AssertThat(count, Equals(6));
+			AssertThat(childIds[0] == functionId, Equals(true));
+
+			// Same result walking the flat hierarchy
+			AST::GetFlatHierarchy(ast);
+			p::TArray<AST::Id> ids;
+			ids.Add(functionId);
+			ids.Add(typeId);
+			ids.Add(typeId);
+			childIds.Clear();
+			AST::GetAllChildren(ast, ids, childIds);
+			AssertThat(childIds.Size(), Equals(count));
+		});
+
+		it("Updates the flat hierarchy in place", [&]() {
+			AST::Tree ast;
+			AST::Id typeId     = AST::CreateType(ast, ASTModule::classType, "Type");
+			AST::Id functionId = AST::AddFunction({ast, typeId}, "Function");
+			AST::Id otherId    = AST::AddFunction({ast, typeId}, "Other");
+			AST::AddIf({ast, otherId});
+			AST::GetFlatHierarchy(ast);
+
+			p::TArray<AST::Id> newIds;
+			newIds.Add(ast.Create());
+			newIds.Add(ast.Create());
+			AST::AttachChildren(ast, functionId, newIds);
+			AssertThat(ast.GetStatic<AST::SHierarchy>().dirty, Equals(false));
+			AssertThat(MatchesRebuild(ast), Equals(true));
+
+			AST::RemoveNodes(ast, functionId);
+			AssertThat(ast.GetStatic<AST::SHierarchy>().dirty, Equals(false));
+			AssertThat(MatchesRebuild(ast), Equals(true));
+		});
+
+		it("Invalidates the flat hierarchy on other changes", [&]() {
+			AST::Tree ast;
+			AST::Id typeId = AST::CreateType(ast, ASTModule::classType, "Type");
+			AST::GetFlatHierarchy(ast);
+
+			AST::AddFunction({ast, typeId}, "Function");
+			AssertThat(ast.GetStatic<AST::SHierarchy>().dirty, Equals(true));
+			AssertThat(AST::GetFlatHierarchy(ast).ids.Size(), Equals(2));
+		});
+	});
+});
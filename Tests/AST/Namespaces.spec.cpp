@@ -1,8 +1,10 @@
 // Copyright 2015-2023 Piperift - All rights reserved
 
 #include <AST/Components/CNamespace.h>
+#include <AST/Statics/SNamespaceCache.h>
 #include <AST/Tree.h>
 #include <AST/Utils/Namespaces.h>
+#include <AST/Utils/TransactionUtils.h>
 #include <AST/Utils/TypeUtils.h>
 #include <ASTModule.h>
 #include <bandit/assertion_frameworks/snowhouse/assert.h>
@@ -58,26 +60,106 @@ go_bandit([]() {
 			AssertThat(ns.c_str(), Equals("TestClass.TestFunction"));
 		});
 
+		it("Can cache full names", [&]() {
+			AST::Tree ast;
+
+			AST::Id parent = ast.Create();
+			ast.Add<AST::CModule>(parent);
+			ast.Add(parent, AST::CNamespace{"SomeModule"});
+			AST::Id classId = AST::CreateType(ast, ASTModule::classType, "TestClass");
+			p::Attach(ast, parent, classId);
+			AST::Id functionId = AST::AddFunction({ast, classId}, "TestFunction");
+
+			AssertThat(AST::GetFullName(ast, functionId).AsString().data(),
+			    Equals("@SomeModule.TestClass.TestFunction"));
+			AssertThat(AST::GetFullName(ast, functionId, true).AsString().data(),
+			    Equals("TestClass.TestFunction"));
+			const auto& cache = ast.GetStatic<AST::SNamespaceCache>();
+			AssertThat(cache.entries.Find(functionId) != nullptr, Equals(true));
+			AssertThat(cache.entries.Find(classId) != nullptr, Equals(true));
+
+			{    // Renaming a parent invalidates its children
+				ScopedChange(ast, classId);
+				ast.Get<AST::CNamespace>(classId).name = "OtherClass";
+			}
+			// Children of changed entities are cached again with the new name
+			AssertThat(cache.entries.Find(functionId)->fullName.AsString().data(),
+			    Equals("@SomeModule.OtherClass.TestFunction"));
+			AssertThat(AST::GetFullName(ast, functionId).AsString().data(),
+			    Equals("@SomeModule.OtherClass.TestFunction"));
+
+			AST::Id otherParent = ast.Create();
+			ast.Add<AST::CModule>(otherParent);
+			ast.Add(otherParent, AST::CNamespace{"OtherModule"});
+			AST::Id functionBId = AST::AddFunction({ast, AST::NoId}, "TestFunctionB");
+			AssertThat(
+			    AST::GetFullName(ast, functionBId).AsString().data(), Equals("@TestFunctionB"));
+			p::Attach(ast, otherParent, functionBId);
+			AssertThat(AST::GetFullName(ast, functionBId).AsString().data(),
+			    Equals("@OtherModule.TestFunctionB"));
+		});
+
+		it("Invalidates cached names on tree copies", [&]() {
+			AST::Tree ast;
+
+			AST::Id parent = ast.Create();
+			ast.Add<AST::CModule>(parent);
+			ast.Add(parent, AST::CNamespace{"SomeModule"});
+			AST::Id classId = AST::CreateType(ast, ASTModule::classType, "TestClass");
+			p::Attach(ast, parent, classId);
+			AST::Id functionId = AST::AddFunction({ast, classId}, "TestFunction");
+			AssertThat(AST::GetFullName(ast, functionId).AsString().data(),
+			    Equals("@SomeModule.TestClass.TestFunction"));
+
+			AST::Tree copy{ast};
+			AssertThat(AST::GetFullName(copy, functionId).AsString().data(),
+			    Equals("@SomeModule.TestClass.TestFunction"));
+			{
+				ScopedChange(copy, classId);
+				copy.Get<AST::CNamespace>(classId).name = "OtherClass";
+			}
+			AssertThat(AST::GetFullName(copy, functionId).AsString().data(),
+			    Equals("@SomeModule.OtherClass.TestFunction"));
+			// The original tree is not affected
+			AssertThat(AST::GetFullName(ast, functionId).AsString().data(),
+			    Equals("@SomeModule.TestClass.TestFunction"));
+		});
+
 		it("Can initialize", [&]() {
 			AST::Namespace ns0{};
-			AssertThat(ns0.scopes[0].IsNone(), Equals(true));
+			AssertThat(ns0[0].IsNone(), Equals(true));
 			AssertThat(ns0.Size(), Equals(0));
 			AssertThat(ns0.IsEmpty(), Equals(true));
 
 			AST::Namespace ns1{"A"};
-			AssertThat(ns1.scopes[0].AsString().data(), Equals("A"));
-			AssertThat(ns1.scopes[1].IsNone(), Equals(true));
+			AssertThat(ns1[0].AsString().data(), Equals("A"));
+			AssertThat(ns1[1].IsNone(), Equals(true));
 			AssertThat(ns1.Size(), Equals(1));
 			AssertThat(ns1.IsEmpty(), Equals(false));
 
 			AST::Namespace ns2{"A", "B"};
-			AssertThat(ns2.scopes[0].AsString().data(), Equals("A"));
-			AssertThat(ns2.scopes[1].AsString().data(), Equals("B"));
-			AssertThat(ns2.scopes[2].IsNone(), Equals(true));
+			AssertThat(ns2[0].AsString().data(), Equals("A"));
+			AssertThat(ns2[1].AsString().data(), Equals("B"));
+			AssertThat(ns2[2].IsNone(), Equals(true));
 			AssertThat(ns2.Size(), Equals(2));
 			AssertThat(ns2.IsEmpty(), Equals(false));
 		});
 
+		it("Can intern", [&]() {
+			AST::Namespace ns0{"A", "B"};
+			AST::Namespace ns1{"@A.B"};
+			AssertThat(ns0 == ns1, Equals(true));
+			AssertThat(ns0.GetHash(), Equals(ns1.GetHash()));
+			AssertThat(ns0.GetParent() == AST::Namespace{"A"}, Equals(true));
+			AssertThat(AST::Namespace{"A"}.Contains(ns0), Equals(true));
+			AssertThat(ns0.Contains(AST::Namespace{"A"}), Equals(false));
+
+			AST::Namespace deep{"@A.B.C.D.E.F.G.H.I.J"};
+			AssertThat(deep.Size(), Equals(10));
+			AssertThat(deep.Last().AsString().data(), Equals("J"));
+			AssertThat(deep.ToString().c_str(), Equals("@A.B.C.D.E.F.G.H.I.J"));
+		});
+
 		it("Can iterate", [&]() {
 			AST::Namespace ns0{};
 			for (const Tag& name : ns0)
@@ -95,7 +177,7 @@ go_bandit([]() {
 			i32 i = 0;
 			for (const Tag& name : ns2)
 			{
-				AssertThat(name.AsString().data(), Equals(ns2.scopes[i].AsString().data()));
+				AssertThat(name.AsString().data(), Equals(ns2[i].AsString().data()));
 				++i;
 			}
 		});
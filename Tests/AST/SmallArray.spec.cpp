@@ -0,0 +1,45 @@
+// Copyright 2015-2023 Piperift - All rights reserved
+
+#include <AST/Utils/SmallArray.h>
+#include <Pipe/Serialize/Formats/JsonFormat.h>
+#include <bandit/bandit.h>
+
+
+using namespace snowhouse;
+using namespace bandit;
+using namespace rift;
+
+
+template<typename T>
+p::String WriteValues(const T& values)
+{
+	p::JsonFormatWriter writer{};
+	p::Writer& w = writer.GetWriter();
+	w.BeginObject();
+	w.Next("values", values);
+	return p::String{writer.ToString()};
+}
+
+go_bandit([]() {
+	describe("AST.SmallArray", []() {
+		it("Serializes like a TArray", [&]() {
+			// Exceeds the inline capacity
+			p::TArray<p::i32> values;
+			for (p::i32 i = 0; i < 6; ++i)
+			{
+				values.Add(i);
+			}
+			const p::String arrayJson = WriteValues(values);
+
+			AST::TSmallArray<p::i32> smallValues;
+			p::JsonFormatReader reader{arrayJson};
+			p::Reader r{reader};
+			r.BeginObject();
+			r.Next("values", smallValues);
+			AssertThat(smallValues.Size(), Equals(6));
+			AssertThat(smallValues[5], Equals(5));
+
+			AssertThat(WriteValues(smallValues), Equals(arrayJson));
+		});
+	});
+});
@@ -0,0 +1,63 @@
+// Copyright 2015-2023 Piperift - All rights reserved
+
+#include <AST/Components/CNamespace.h>
+#include <AST/Tree.h>
+#include <AST/Utils/Namespaces.h>
+#include <AST/Utils/Snapshots.h>
+#include <AST/Utils/TransactionUtils.h>
+#include <AST/Utils/TypeUtils.h>
+#include <ASTModule.h>
+#include <bandit/bandit.h>
+
+
+using namespace snowhouse;
+using namespace bandit;
+using namespace rift;
+
+
+go_bandit([]() {
+	describe("AST.Snapshots", []() {
+		it("Reuses snapshots until the tree is edited", [&]() {
+			AST::Tree ast;
+			AST::Id typeId = AST::CreateType(ast, ASTModule::classType, "A");
+
+			AST::TreeSnapshot snapshot = AST::TakeSnapshot(ast);
+			AssertThat(bool(snapshot), Equals(true));
+			AssertThat(AST::IsSnapshotOutdated(ast, snapshot), Equals(false));
+			AssertThat(bool(AST::FindSnapshot(ast)), Equals(true));
+
+			{
+				ScopedChange(ast, typeId);
+				ast.Get<AST::CNamespace>(typeId).name = "B";
+			}
+			AssertThat(AST::IsSnapshotOutdated(ast, snapshot), Equals(true));
+			AssertThat(bool(AST::FindSnapshot(ast)), Equals(false));
+
+			AST::TreeSnapshot newSnapshot = AST::TakeSnapshot(ast);
+			AssertThat(AST::GetName(*newSnapshot, typeId).AsString().data(), Equals("B"));
+			// The previous snapshot was replaced
+			AssertThat(bool(snapshot), Equals(false));
+		});
+
+		it("Detects every edit of an entity", [&]() {
+			AST::Tree ast;
+			AST::Id typeId = AST::CreateType(ast, ASTModule::classType, "A");
+			{
+				ScopedChange(ast, typeId);
+				ast.Get<AST::CNamespace>(typeId).name = "B";
+			}
+
+			// The entity is still marked as changed. Editing it again must be detected too
+			AST::TreeSnapshot snapshot = AST::TakeSnapshot(ast);
+			{
+				ScopedChange(ast, typeId);
+				ast.Get<AST::CNamespace>(typeId).name = "C";
+			}
+			AssertThat(AST::IsSnapshotOutdated(ast, snapshot), Equals(true));
+
+			AST::Transactions::Undo(ast);
+			snapshot = AST::TakeSnapshot(ast);
+			AssertThat(AST::GetName(*snapshot, typeId).AsString().data(), Equals("B"));
+		});
+	});
+});
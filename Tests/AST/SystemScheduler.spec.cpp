@@ -0,0 +1,94 @@
+// Copyright 2015-2023 Piperift - All rights reserved
+
+#include <AST/Components/CExprType.h>
+#include <AST/Components/CNamespace.h>
+#include <AST/Statics/SReferences.h>
+#include <AST/Systems/TypeSystem.h>
+#include <AST/Tree.h>
+#include <AST/Utils/SystemScheduler.h>
+#include <bandit/bandit.h>
+
+
+using namespace snowhouse;
+using namespace bandit;
+using namespace rift;
+
+
+namespace
+{
+	p::TArray<p::i32> runOrder;
+
+	void RunFirst(p::TAccessRef<p::TWrite<AST::CNamespace>> access)
+	{
+		runOrder.Add(1);
+	}
+	void RunSecond(p::TAccessRef<p::TWrite<AST::CNamespace>> access)
+	{
+		runOrder.Add(2);
+	}
+	void ReadNames(p::TAccessRef<AST::CNamespace> access) {}
+}    // namespace
+
+
+go_bandit([]() {
+	describe("AST.SystemScheduler", []() {
+		it("Detects conflicting accesses", [&]() {
+			AST::SystemAccess reader;
+			reader.reads.Add(p::GetTypeId<AST::CNamespace>());
+			AST::SystemAccess otherReader = reader;
+			AST::SystemAccess writer;
+			writer.writes.Add(p::GetTypeId<AST::CNamespace>());
+			AST::SystemAccess otherWriter;
+			otherWriter.writes.Add(p::GetTypeId<AST::CExprTypeId>());
+			AST::SystemAccess exclusive;
+			exclusive.exclusive = true;
+
+			AssertThat(reader.Conflicts(otherReader), Equals(false));
+			AssertThat(reader.Conflicts(writer), Equals(true));
+			AssertThat(writer.Conflicts(reader), Equals(true));
+			AssertThat(writer.Conflicts(otherWriter), Equals(false));
+			AssertThat(reader.Conflicts(exclusive), Equals(true));
+		});
+
+		it("Deduces accesses of systems", [&]() {
+			AST::SystemScheduler scheduler;
+			scheduler.Add("ResolveExprTypeIds", &AST::TypeSystem::ResolveExprTypeIds);
+			scheduler.Add("ReadNames", &ReadNames).Reads<AST::SReferences>();
+
+			const auto& resolve = scheduler.GetSystems()[0].access;
+			AssertThat(resolve.exclusive, Equals(false));
+			AssertThat(resolve.writes.Contains(p::GetTypeId<AST::CExprTypeId>()), Equals(true));
+			AssertThat(resolve.reads.Contains(p::GetTypeId<AST::CExprType>()), Equals(true));
+
+			const auto& readNames = scheduler.GetSystems()[1].access;
+			AssertThat(readNames.reads.Contains(p::GetTypeId<AST::SReferences>()), Equals(true));
+			AssertThat(resolve.Conflicts(readNames), Equals(false));
+		});
+
+		it("Adds hook writes of written components", [&]() {
+			AST::Tree ast;    // Binds the hooks of the reference index
+			AST::SystemScheduler scheduler;
+			scheduler.Add("ResolveExprTypeIds", &AST::TypeSystem::ResolveExprTypeIds);
+			scheduler.Add("ReadNames", &ReadNames).Reads<AST::SReferences>();
+
+			AST::SystemAccess resolve = scheduler.GetSystems()[0].access;
+			AST::AddHookWrites(resolve);
+			AssertThat(resolve.writes.Contains(p::GetTypeId<AST::SReferences>()), Equals(true));
+			AssertThat(resolve.Conflicts(scheduler.GetSystems()[1].access), Equals(true));
+		});
+
+		it("Runs conflicting systems in order", [&]() {
+			AST::Tree ast;
+			AST::SystemScheduler scheduler;
+			scheduler.Add("RunFirst", &RunFirst);
+			scheduler.Add("RunSecond", &RunSecond);
+
+			runOrder.Clear();
+			scheduler.Run(ast);
+			AssertThat(runOrder.Size(), Equals(2));
+			AssertThat(runOrder[0], Equals(1));
+			AssertThat(runOrder[1], Equals(2));
+			AssertThat(scheduler.GetTimes().Size(), Equals(2));
+		});
+	});
+});
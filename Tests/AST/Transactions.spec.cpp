@@ -0,0 +1,94 @@
+// Copyright 2015-2023 Piperift - All rights reserved
+
+#include <AST/Components/CDeclFunction.h>
+#include <AST/Components/CDeclNative.h>
+#include <AST/Components/CDeclType.h>
+#include <AST/Components/CNamespace.h>
+#include <AST/Components/CStmtFor.h>
+#include <AST/Tree.h>
+#include <AST/Utils/Compaction.h>
+#include <AST/Utils/TransactionUtils.h>
+#include <AST/Utils/TypeUtils.h>
+#include <ASTModule.h>
+#include <bandit/bandit.h>
+
+
+using namespace snowhouse;
+using namespace bandit;
+using namespace rift;
+
+
+namespace
+{
+	// @return ids of types, excluding native ones
+	p::TArray<AST::Id> FindTypeIds(AST::Tree& ast)
+	{
+		p::TArray<AST::Id> typeIds = p::FindAllIdsWith<AST::CDeclType>(ast);
+		p::ExcludeIdsWith<AST::CDeclNative>(ast, typeIds);
+		return typeIds;
+	}
+}    // namespace
+
+
+go_bandit([]() {
+	describe("AST.Transactions", []() {
+		it("Can undo removing a type", [&]() {
+			AST::Tree ast;
+			AST::Id typeId = AST::CreateType(ast, ASTModule::classType, "Type");
+			AST::AddFunction({ast, typeId}, "Function");
+
+			AST::RemoveNodes(ast, typeId);
+			AssertThat(FindTypeIds(ast).Size(), Equals(0));
+			AssertThat(p::FindAllIdsWith<AST::CDeclFunction>(ast).Size(), Equals(0));
+
+			AssertThat(AST::Transactions::Undo(ast), Equals(true));
+			// Removed entities are restored with new ids
+			p::TArray<AST::Id> typeIds = FindTypeIds(ast);
+			AssertThat(typeIds.Size(), Equals(1));
+			AssertThat(ast.Get<AST::CNamespace>(typeIds[0]).name.AsString().data(),
+			    Equals("Type"));
+			p::TArray<AST::Id> functionIds;
+			p::GetChildren(ast, typeIds[0], functionIds);
+			AssertThat(functionIds.Size(), Equals(1));
+			AssertThat(ast.Has<AST::CDeclFunction>(functionIds[0]), Equals(true));
+
+			AssertThat(AST::Transactions::Redo(ast), Equals(true));
+			AssertThat(FindTypeIds(ast).Size(), Equals(0));
+		});
+
+		it("Can undo removing a for statement", [&]() {
+			AST::Tree ast;
+			AST::Id typeId     = AST::CreateType(ast, ASTModule::classType, "Type");
+			AST::Id functionId = AST::AddFunction({ast, typeId}, "Function");
+			AST::Id forId      = ast.Create();
+			ast.Add<AST::CStmtFor>(forId);
+			p::Attach(ast, functionId, forId);
+
+			AST::RemoveNodes(ast, forId);
+			AssertThat(p::FindAllIdsWith<AST::CStmtFor>(ast).Size(), Equals(0));
+
+			AssertThat(AST::Transactions::Undo(ast), Equals(true));
+			p::TArray<AST::Id> forIds = p::FindAllIdsWith<AST::CStmtFor>(ast);
+			AssertThat(forIds.Size(), Equals(1));
+			AssertThat(p::GetParent(ast, forIds[0]) == functionId, Equals(true));
+
+			AssertThat(AST::Transactions::Redo(ast), Equals(true));
+			AssertThat(p::FindAllIdsWith<AST::CStmtFor>(ast).Size(), Equals(0));
+		});
+
+		it("Can undo after compacting", [&]() {
+			AST::Tree ast;
+			AST::Id typeId = AST::CreateType(ast, ASTModule::classType, "Type");
+			AST::AddFunction({ast, typeId}, "Function");
+			AST::RemoveNodes(ast, typeId);
+
+			AssertThat(AST::CompactTree(ast), Equals(true));
+			AssertThat(AST::Transactions::Undo(ast), Equals(true));
+			p::TArray<AST::Id> typeIds = FindTypeIds(ast);
+			AssertThat(typeIds.Size(), Equals(1));
+			p::TArray<AST::Id> functionIds;
+			p::GetChildren(ast, typeIds[0], functionIds);
+			AssertThat(functionIds.Size(), Equals(1));
+		});
+	});
+});